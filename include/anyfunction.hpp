@@ -25,9 +25,18 @@
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
 
 // External headers
+#include <atomic>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -36,6 +45,37 @@
 // ▁ Exceptions ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
 
+// Exception support, disabled if the compiler does not support exceptions (e.g. '-fno-exceptions') or if 'ANYFUNCTION_NO_EXCEPTIONS' is defined
+#if !defined(ANYFUNCTION_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#define ANYFUNCTION_NO_EXCEPTIONS
+#endif
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+#define ANYFUNCTION_TRY try
+#define ANYFUNCTION_CATCH_ALL catch (...)
+#define ANYFUNCTION_RETHROW throw
+#else
+#define ANYFUNCTION_TRY if (true)
+#define ANYFUNCTION_CATCH_ALL else
+#define ANYFUNCTION_RETHROW
+#endif
+
+// Empty holder call policies, selected by defining 'ANYFUNCTION_EMPTY_CALL' to one of them
+#define ANYFUNCTION_EMPTY_CALL_THROW     0 // Throw 'Exception::Empty' (default if exceptions are supported)
+#define ANYFUNCTION_EMPTY_CALL_ABORT     1 // Call '::std::abort' (default otherwise)
+#define ANYFUNCTION_EMPTY_CALL_HOOK      2 // Call the hook set with 'set_empty_call_hook', then '::std::abort' if the hook returns
+#define ANYFUNCTION_EMPTY_CALL_DEFAULT   3 // Return a value-initialized value (not supported for reference return types)
+#define ANYFUNCTION_EMPTY_CALL_UNCHECKED 4 // Undefined behavior, asserted in debug builds
+#ifndef ANYFUNCTION_EMPTY_CALL
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+#define ANYFUNCTION_EMPTY_CALL ANYFUNCTION_EMPTY_CALL_THROW
+#else
+#define ANYFUNCTION_EMPTY_CALL ANYFUNCTION_EMPTY_CALL_ABORT
+#endif
+#endif
+#if ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_THROW && defined(ANYFUNCTION_NO_EXCEPTIONS)
+#error "'ANYFUNCTION_EMPTY_CALL_THROW' requires exception support"
+#endif
+
 namespace AnyFunction {
 namespace Exception {
 
@@ -61,16 +101,513 @@ namespace Exception {
 **/
 EXCEPTION(Any, ::std::exception, "exception");
     EXCEPTION(Empty, Any, "no function to call");
+    EXCEPTION(Overflow, Any, "closure does not fit in the local storage of a heap-free function holder");
+    EXCEPTION(BrokenPromise, Any, "promise destroyed without a value");
+    EXCEPTION(NoState, Any, "future or promise without shared state");
 
 #undef EXCEPTION
 
 // ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
 
+/** Raise an exception, or abort if exceptions are not supported.
+ * @param Error Exception class to raise
+**/
+template<class Error> [[noreturn]] void raise() {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+    throw Error();
+#else
+    ::std::abort();
+#endif
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
 }
 }
 
 // ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Exceptions ▔
+// ▁ Memory resources ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Memory resource interface, used to allocate heap-stored functors.
+**/
+class MemoryResource {
+public:
+    /** Virtual destructor.
+    **/
+    virtual ~MemoryResource() {}
+public:
+    /** Allocate a memory block.
+     * @param size  Size of the block (in bytes)
+     * @param align Alignment of the block (in bytes)
+     * @return Pointer to the allocated block (never nullptr)
+    **/
+    void* allocate(size_t size, size_t align) {
+        return do_allocate(size, align);
+    }
+    /** Free a memory block.
+     * @param ptr   Pointer to the block, as returned by 'allocate'
+     * @param size  Size of the block, as passed to 'allocate'
+     * @param align Alignment of the block, as passed to 'allocate'
+    **/
+    void deallocate(void* ptr, size_t size, size_t align) noexcept {
+        do_deallocate(ptr, size, align);
+    }
+    /** Tell whether the given resource can free the blocks allocated by this resource, and vice versa.
+     * @param other Other resource
+     * @return True if blocks can be interchanged, false otherwise
+    **/
+    bool is_equal(MemoryResource const& other) const noexcept {
+        return this == &other || do_is_equal(other);
+    }
+protected:
+    /** Actual implementations, see 'allocate', 'deallocate' and 'is_equal'.
+    **/
+    virtual void* do_allocate(size_t size, size_t align) = 0;
+    virtual void do_deallocate(void* ptr, size_t size, size_t align) noexcept = 0;
+    virtual bool do_is_equal(MemoryResource const&) const noexcept {
+        return false;
+    }
+};
+
+/** Tell whether two (optional) memory resources are interchangeable.
+ * @param a First resource, nullptr for the functor class operators 'new' and 'delete'
+ * @param b Second resource, nullptr for the functor class operators 'new' and 'delete'
+ * @return True if blocks can be interchanged, false otherwise
+**/
+static inline bool same_resource(MemoryResource const* a, MemoryResource const* b) noexcept {
+    if (!a || !b)
+        return a == b;
+    return a->is_equal(*b);
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Size-class pool memory resource, with per-thread free lists.
+ *
+ * Blocks up to 'max_size' bytes (and aligned at most on 'granularity') are served from free lists owned by the allocating thread,
+ * bucketed by size classes of 'granularity' bytes. A block freed by another thread is pushed (lock-free) on a list of the owning
+ * thread, which takes it back on its next miss. The free lists of a thread are released when it exits; blocks still in use at that
+ * time get released when freed. Larger or over-aligned blocks are served by the global operators 'new' and 'delete'.
+**/
+class PoolResource final: public MemoryResource {
+    friend PoolResource* pool_resource() noexcept;
+public:
+    /** Pool parameters.
+    **/
+    constexpr static size_t granularity = alignof(::std::max_align_t); // Size class step, and maximum alignment served
+    constexpr static size_t max_size    = 256; // Maximum block size served
+    constexpr static size_t nb_classes  = max_size / granularity; // Number of size classes
+    /** Per-thread pool statistics.
+    **/
+    struct Statistics {
+        uint64_t hits;         // Allocations served from a free list
+        uint64_t misses;       // Allocations served by the global operator 'new' (then later reused)
+        uint64_t fallbacks;    // Allocations too large or over-aligned for the pool
+        uint64_t remote_frees; // Blocks freed to another (possibly exited) thread
+        /** Get the ratio of pool allocations served from a free list.
+         * @return Hit rate, in [0, 1]
+        **/
+        double hit_rate() const noexcept {
+            return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.;
+        }
+    };
+private:
+    struct Cache;
+    /** Block header, preceding each pooled block.
+    **/
+    struct alignas(granularity) Header {
+        union {
+            Cache*  owner; // Owning thread cache, while in use
+            Header* next;  // Next free block, while in a free list (of the owning thread cache)
+        };
+    };
+    /** Per-thread cache.
+    **/
+    struct Cache {
+        Header* local[nb_classes]; // Free lists, only accessed by the owning thread
+        ::std::atomic<Header*> remote[nb_classes]; // Blocks freed by other threads, or 'closed()' once the owning thread exited
+        ::std::atomic<size_t> refs; // Owning thread (if alive) + number of allocated blocks
+        Statistics stats; // Owning thread statistics
+        /** Zero-initialization constructor.
+        **/
+        Cache() noexcept: local(), refs(1), stats() {
+            for (auto&& list: remote)
+                list.store(nullptr, ::std::memory_order_relaxed);
+        }
+        /** Drop references, delete the cache when the last one is dropped.
+         * @param count Number of references to drop
+        **/
+        void release(size_t count) noexcept {
+            if (refs.fetch_sub(count, ::std::memory_order_acq_rel) == count)
+                delete this;
+        }
+    };
+    /** Per-thread state, trivially destructible so it remains readable after thread-exit destructors ran.
+    **/
+    struct State {
+        Cache* cache; // Cache of the current thread, nullptr if not created (yet) or closed
+        bool closed;  // Whether the cache of the current thread has been closed
+    };
+    /** Per-thread cache guard, closing the cache on thread exit.
+    **/
+    struct Guard {
+        Guard() {
+            state().cache = new Cache(); // Can throw
+        }
+        ~Guard() {
+            auto& current = state();
+            close(current.cache);
+            current.cache = nullptr;
+            current.closed = true;
+        }
+    };
+private:
+    /** Sentinel marking the remote free lists of an exited thread.
+     * @return Sentinel value
+    **/
+    static Header* closed() noexcept {
+        return reinterpret_cast<Header*>(alignof(Header));
+    }
+    /** Get the per-thread state.
+     * @return Reference to the state of the current thread
+    **/
+    static State& state() noexcept {
+        static thread_local State state; // Zero-initialized
+        return state;
+    }
+    /** Get (or create) the cache of the current thread.
+     * @return Cache of the current thread, nullptr if the thread is exiting
+    **/
+    static Cache* cache() {
+        auto& current = state();
+        if (current.cache)
+            return current.cache;
+        if (current.closed) // Thread is exiting
+            return nullptr;
+        static thread_local Guard guard; // Can throw
+        return current.cache;
+    }
+    /** Close the cache of an exiting thread: release its free blocks, and redirect further remote frees to the global operator 'delete'.
+     * @param cache Cache to close
+    **/
+    static void close(Cache* cache) noexcept {
+        size_t count = 1; // Owning thread
+        for (size_t i = 0; i < nb_classes; ++i) {
+            for (auto list: {cache->local[i], cache->remote[i].exchange(closed(), ::std::memory_order_acq_rel)}) {
+                while (list) {
+                    auto next = list->next;
+                    ::operator delete(list);
+                    list = next;
+                    ++count;
+                }
+            }
+        }
+        cache->release(count);
+    }
+    /** Get the size class of a request.
+     * @param size  Requested size
+     * @param align Requested alignment
+     * @return Size class index, or 'nb_classes' if not served by the pool
+    **/
+    static size_t size_class(size_t size, size_t align) noexcept {
+        if (size > max_size || align > granularity)
+            return nb_classes;
+        return (size + granularity - 1) / granularity - (size > 0 ? 1 : 0);
+    }
+    /** Allocate/free a block not served by the pool, with the global operators 'new' and 'delete'.
+     * Over-aligned blocks are over-allocated, the pointer to the actual allocation being stored right before the aligned block.
+     * @param size  Requested size
+     * @param align Requested alignment
+     * @param ptr   Pointer to the block, as returned by 'fallback_allocate'
+     * @return Pointer to the block
+    **/
+    static void* fallback_allocate(size_t size, size_t align) {
+        if (align <= granularity)
+            return ::operator new(size); // Can throw
+        if (size > static_cast<size_t>(-1) - align)
+            Exception::raise<::std::bad_alloc>();
+        auto base = ::operator new(size + align); // Can throw, at least aligned on 'granularity' so leaves room for the stored pointer
+        auto block = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(base) + align) & ~(static_cast<uintptr_t>(align) - 1));
+        static_cast<void**>(block)[-1] = base;
+        return block;
+    }
+    static void fallback_deallocate(void* ptr, size_t align) noexcept {
+        if (align <= granularity) {
+            ::operator delete(ptr);
+            return;
+        }
+        ::operator delete(static_cast<void**>(ptr)[-1]);
+    }
+private:
+    /** Singleton constructor.
+    **/
+    PoolResource() noexcept {}
+protected:
+    void* do_allocate(size_t size, size_t align) {
+        auto index = size_class(size, align);
+        if (index >= nb_classes) { // Not served by the pool
+            auto cache = state().cache;
+            if (cache)
+                ++cache->stats.fallbacks;
+            return fallback_allocate(size, align); // Can throw
+        }
+        auto cache = PoolResource::cache(); // Can throw
+        if (!cache) { // Thread is exiting, allocate an unowned block
+            auto block = static_cast<Header*>(::operator new(sizeof(Header) + (index + 1) * granularity)); // Can throw
+            block->owner = nullptr;
+            return block + 1;
+        }
+        auto block = cache->local[index];
+        if (!block) // Take back the blocks freed by other threads
+            block = cache->remote[index].exchange(nullptr, ::std::memory_order_acquire);
+        if (block) { // Hit
+            cache->local[index] = block->next;
+            ++cache->stats.hits;
+        } else { // Miss
+            block = static_cast<Header*>(::operator new(sizeof(Header) + (index + 1) * granularity)); // Can throw
+            cache->refs.fetch_add(1, ::std::memory_order_relaxed);
+            ++cache->stats.misses;
+        }
+        block->owner = cache;
+        return block + 1;
+    }
+    void do_deallocate(void* ptr, size_t size, size_t align) noexcept {
+        auto index = size_class(size, align);
+        if (index >= nb_classes) { // Not served by the pool
+            fallback_deallocate(ptr, align);
+            return;
+        }
+        auto block = static_cast<Header*>(ptr) - 1;
+        auto owner = block->owner;
+        if (!owner) { // Unowned block
+            ::operator delete(block);
+            return;
+        }
+        auto cache = state().cache;
+        if (owner == cache) { // Local free
+            block->next = cache->local[index];
+            cache->local[index] = block;
+            return;
+        }
+        if (cache)
+            ++cache->stats.remote_frees;
+        auto& list = owner->remote[index];
+        auto head = list.load(::std::memory_order_relaxed);
+        do {
+            if (head == closed()) { // Owning thread exited
+                ::operator delete(block);
+                owner->release(1);
+                return;
+            }
+            block->next = head;
+        } while (!list.compare_exchange_weak(head, block, ::std::memory_order_release, ::std::memory_order_relaxed));
+    }
+public:
+    /** Get the statistics of the current thread.
+     * @return Statistics of the current thread (all zeros if the thread never used the pool)
+    **/
+    static Statistics statistics() noexcept {
+        auto cache = state().cache;
+        return cache ? cache->stats : Statistics{};
+    }
+    /** Reset the statistics of the current thread.
+    **/
+    static void reset_statistics() noexcept {
+        auto cache = state().cache;
+        if (cache)
+            cache->stats = Statistics{};
+    }
+};
+
+/** Get the pool memory resource.
+ * @return Pointer to the (unique) pool memory resource
+**/
+inline PoolResource* pool_resource() noexcept {
+    static PoolResource pool;
+    return &pool;
+}
+
+/** Get the default memory resource for function holders.
+ * @return The pool memory resource if 'ANYFUNCTION_POOL_BY_DEFAULT' is defined, nullptr (i.e. the functor class operators 'new' and 'delete') otherwise
+**/
+static inline MemoryResource* default_resource() noexcept {
+#ifdef ANYFUNCTION_POOL_BY_DEFAULT
+    return pool_resource();
+#else
+    return nullptr;
+#endif
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Memory resources ▔
+// ▁ Statistics ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Closure placement statistics of a function object holder class (i.e. per signature, storage size, policy and alignment).
+ * Only recorded if 'ANYFUNCTION_STATISTICS' is defined, see 'Function::statistics'.
+**/
+class Statistics final {
+public:
+    /** Operation that placed a closure.
+    **/
+    enum class Operation {
+        construct, // Construction from a closure (or in place)
+        copy,      // Copy from another holder
+        move       // Move from another holder
+    };
+    constexpr static size_t nb_size_buckets  = 10; // Closure size histogram buckets: up to 8, 16, 32, ..., 2048 bytes, then larger
+    constexpr static size_t nb_align_buckets = 8;  // Closure alignment histogram buckets: 1, 2, 4, ..., 64 bytes, then larger
+    using Counter = ::std::atomic<size_t>;
+public:
+    char const* const name; // Holder class name (compiler-specific)
+    size_t const capacity;  // Local storage size of the holder class
+    size_t const alignment; // Local storage alignment of the holder class
+    Counter constructions; // Closures placed by construction
+    Counter copies;        // Closures placed by copy
+    Counter moves;         // Closures placed by move
+    Counter local;  // Closures placed in the local storage
+    Counter remote; // Closures placed on the heap (including shared and taken-over ones)
+    Counter too_large;     // Heap placements of closures larger than the local storage
+    Counter too_aligned;   // Heap placements of closures more aligned than the local storage
+    Counter throwing_move; // Heap placements of closures that fit, but whose move constructor could throw (and not trivially relocatable)
+    Counter heap_allocations; // Heap blocks allocated
+    Counter heap_bytes;       // Heap bytes allocated
+    Counter sizes[nb_size_buckets];   // Histogram of placed closure sizes
+    Counter aligns[nb_align_buckets]; // Histogram of placed closure alignments
+private:
+    Statistics* next; // Next registered statistics
+    /** Get the head of the list of registered statistics.
+     * @return Head of the list
+    **/
+    static ::std::atomic<Statistics*>& head() noexcept {
+        static ::std::atomic<Statistics*> head{nullptr};
+        return head;
+    }
+    /** Get the histogram bucket of a value.
+     * @param value      Value to classify
+     * @param first      Upper bound of the first bucket (a power of 2)
+     * @param nb_buckets Number of buckets
+     * @return Bucket index
+    **/
+    static size_t bucket(size_t value, size_t first, size_t nb_buckets) noexcept {
+        size_t index = 0;
+        for (auto bound = first; value > bound && index < nb_buckets - 1; bound *= 2)
+            ++index;
+        return index;
+    }
+public:
+    /** Zero-initialized, registered statistics constructor.
+     * @param name      Holder class name
+     * @param capacity  Local storage size of the holder class
+     * @param alignment Local storage alignment of the holder class
+    **/
+    Statistics(char const* name, size_t capacity, size_t alignment) noexcept: name(name), capacity(capacity), alignment(alignment) {
+        reset();
+        next = head().load(::std::memory_order_relaxed);
+        while (!head().compare_exchange_weak(next, this, ::std::memory_order_release, ::std::memory_order_relaxed));
+    }
+    Statistics(Statistics const&) = delete;
+    Statistics& operator=(Statistics const&) = delete;
+public:
+    /** Record one closure placement.
+     * @param operation Operation that placed the closure
+     * @param size      Closure size
+     * @param align     Closure alignment
+     * @param movable   Whether the closure move constructor does not throw (or the closure is trivially relocatable)
+     * @param remote    Whether the closure has been placed on the heap
+     * @param allocated Whether a heap block has been allocated for the closure
+    **/
+    void record(Operation operation, size_t size, size_t align, bool movable, bool remote, bool allocated) noexcept {
+        constexpr auto relaxed = ::std::memory_order_relaxed;
+        switch (operation) {
+            case Operation::construct:
+                constructions.fetch_add(1, relaxed);
+                break;
+            case Operation::copy:
+                copies.fetch_add(1, relaxed);
+                break;
+            case Operation::move:
+                moves.fetch_add(1, relaxed);
+                break;
+        }
+        sizes[bucket(size, 8, nb_size_buckets)].fetch_add(1, relaxed);
+        aligns[bucket(align, 1, nb_align_buckets)].fetch_add(1, relaxed);
+        if (!remote) {
+            local.fetch_add(1, relaxed);
+            return;
+        }
+        this->remote.fetch_add(1, relaxed);
+        if (size > capacity) {
+            too_large.fetch_add(1, relaxed);
+        } else if (align > alignment) {
+            too_aligned.fetch_add(1, relaxed);
+        } else if (!movable) {
+            throwing_move.fetch_add(1, relaxed);
+        }
+        if (allocated) {
+            heap_allocations.fetch_add(1, relaxed);
+            heap_bytes.fetch_add(size, relaxed);
+        }
+    }
+    /** Reset all the counters to zero.
+    **/
+    void reset() noexcept {
+        constexpr auto relaxed = ::std::memory_order_relaxed;
+        for (auto counter: {&constructions, &copies, &moves, &local, &remote, &too_large, &too_aligned, &throwing_move, &heap_allocations, &heap_bytes})
+            counter->store(0, relaxed);
+        for (auto&& counter: sizes)
+            counter.store(0, relaxed);
+        for (auto&& counter: aligns)
+            counter.store(0, relaxed);
+    }
+    /** Call a function on every registered statistics, i.e. on the statistics of every holder class used so far.
+     * @param visit Function to call with each statistics (as 'Statistics&')
+    **/
+    template<class Visitor> static void for_each(Visitor&& visit) {
+        for (auto stats = head().load(::std::memory_order_acquire); stats; stats = stats->next)
+            visit(*stats);
+    }
+    /** Dump every registered statistics, one line per holder class with 'key=value' fields.
+     * @param stream Stream to write to
+    **/
+    static void dump(::std::FILE* stream) {
+        for_each([stream](Statistics& stats) {
+            auto get = [](Counter const& counter) -> unsigned long long {
+                return counter.load(::std::memory_order_relaxed);
+            };
+            ::std::fprintf(stream, "capacity=%zu alignment=%zu constructions=%llu copies=%llu moves=%llu local=%llu remote=%llu too_large=%llu too_aligned=%llu throwing_move=%llu heap_allocations=%llu heap_bytes=%llu sizes=",
+                stats.capacity, stats.alignment, get(stats.constructions), get(stats.copies), get(stats.moves), get(stats.local), get(stats.remote),
+                get(stats.too_large), get(stats.too_aligned), get(stats.throwing_move), get(stats.heap_allocations), get(stats.heap_bytes));
+            for (size_t i = 0; i < nb_size_buckets; ++i)
+                ::std::fprintf(stream, i > 0 ? ",%llu" : "%llu", get(stats.sizes[i]));
+            ::std::fprintf(stream, " aligns=");
+            for (size_t i = 0; i < nb_align_buckets; ++i)
+                ::std::fprintf(stream, i > 0 ? ",%llu" : "%llu", get(stats.aligns[i]));
+            ::std::fprintf(stream, " holder=\"%s\"\n", stats.name);
+        });
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Statistics ▔
 // ▁ Function object holder class ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
 
@@ -78,240 +615,878 @@ namespace AnyFunction {
 
 // ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
 
+/** Function object holder policies.
+**/
+struct DefaultPolicy {
+    constexpr static bool copyable = true; // Whether holders (and so stored functors) are copyable
+    constexpr static bool shared = false; // Whether heap-stored functors are shared (reference counted) between copies
+    constexpr static bool atomic_refs = true; // Whether reference counts of shared functors are atomic (i.e. copies can be used by different threads)
+    constexpr static bool heap = true; // Whether functors that do not fit in the local storage are heap-stored (otherwise they are rejected)
+};
+struct UniquePolicy: DefaultPolicy {
+    constexpr static bool copyable = false;
+};
+struct SharedPolicy: DefaultPolicy {
+    constexpr static bool shared = true;
+};
+struct SharedNonAtomicPolicy: SharedPolicy {
+    constexpr static bool atomic_refs = false;
+};
+struct InplacePolicy: DefaultPolicy {
+    constexpr static bool heap = false;
+};
+
 /** Function object holder template class declaration.
 **/
-template<class Any, size_t local_storage_size = 32> class Function;
+template<class Any, size_t local_storage_size = 32, class Policy = DefaultPolicy, size_t local_storage_align = alignof(::std::max_align_t)> class Function;
+
+/** Move-only function object holder template alias.
+**/
+template<class Any, size_t local_storage_size = 32, size_t local_storage_align = alignof(::std::max_align_t)> using UniqueFunction = Function<Any, local_storage_size, UniquePolicy, local_storage_align>;
+
+/** Shared (heap-stored functors are reference counted) function object holder template alias.
+**/
+template<class Any, size_t local_storage_size = 32, size_t local_storage_align = alignof(::std::max_align_t)> using SharedFunction = Function<Any, local_storage_size, SharedPolicy, local_storage_align>;
+
+/** Heap-free (functors are always stored locally) function object holder template alias.
+**/
+template<class Any, size_t local_storage_size = 32, size_t local_storage_align = alignof(::std::max_align_t)> using InplaceFunction = Function<Any, local_storage_size, InplacePolicy, local_storage_align>;
+
+/** Function object reference template class declaration.
+**/
+template<class Any> class FunctionRef;
+
+/** Atomic function object holder template class declaration.
+**/
+template<class Any, size_t local_storage_size = 32, class Policy = DefaultPolicy, size_t local_storage_align = alignof(::std::max_align_t)> class AtomicFunction;
+
+/** Batch invocation helpers class declaration (see 'anyfunction_batch.hpp').
+**/
+class Batch;
+
+/** Multi-signature tag, i.e. the expected function type of holders of a functor callable with several signatures.
+ * @param Signatures... Expected function types (at least two), the first one being the fastest to call
+**/
+template<class... Signatures> struct Overloads {};
 
 /** Check if a given class instance is an instance of 'Function' class template.
  * @param Type Type to identify
 **/
 template<class Type> class is_function_holder: public ::std::false_type {};
-template<class Return, class... Args, size_t local_storage_size> class is_function_holder<Function<Return(Args...), local_storage_size>>: public ::std::true_type {};
+template<class Any, size_t local_storage_size, class Policy, size_t local_storage_align> class is_function_holder<Function<Any, local_storage_size, Policy, local_storage_align>>: public ::std::true_type {};
+
+/** In-place construction tag, selecting the functor class to construct.
+ * @param Functor Functor class to construct
+**/
+template<class Functor> struct in_place_type_t {
+    explicit in_place_type_t() = default;
+};
+template<class Functor> constexpr in_place_type_t<Functor> in_place_type{};
+
+/** Check if a given class instance is an instance of 'in_place_type_t' class template.
+ * @param Type Type to identify
+**/
+template<class Type> class is_in_place_type: public ::std::false_type {};
+template<class Functor> class is_in_place_type<in_place_type_t<Functor>>: public ::std::true_type {};
 
-/** Enable template overload only if the given type is not a 'Function' class template instance.
+/** Functor class identity, without RTTI (see 'type_id').
+**/
+class TypeId final {
+private:
+    void const* tag; // Address unique to the identified class (nullptr for none)
+public:
+    /** No class/given tag constructor.
+     * @param tag Address unique to the identified class
+    **/
+    constexpr TypeId() noexcept: tag(nullptr) {}
+    constexpr explicit TypeId(void const* tag) noexcept: tag(tag) {}
+    /** Compare with another identity.
+     * @param other Identity to compare with
+     * @return Whether both identify the same class
+    **/
+    constexpr bool operator==(TypeId const& other) const noexcept {
+        return tag == other.tag;
+    }
+    constexpr bool operator!=(TypeId const& other) const noexcept {
+        return tag != other.tag;
+    }
+    /** Tell whether a class is identified.
+     * @return True if identifies a class, false otherwise
+    **/
+    constexpr explicit operator bool() const noexcept {
+        return tag != nullptr;
+    }
+};
+
+/** Per-class tag, not constant so that identical code/data folding can not merge the tags of different classes.
+ * @param Type Class to tag
+**/
+template<class Type> class type_tag {
+public:
+    static char value;
+};
+template<class Type> char type_tag<Type>::value;
+
+/** Get the identity of a given class.
+ * @param Type Class to identify (cv-qualifiers and references are ignored)
+ * @return Class identity
+**/
+template<class Type> constexpr TypeId type_id() noexcept {
+    return TypeId{&type_tag<typename ::std::remove_cv<typename ::std::remove_reference<Type>::type>::type>::value};
+}
+
+/** Enable template overload only if the given type is not a 'Function' class template instance (nor an in-place construction tag).
  * @param Type Type to decay then identify
 **/
-template<class Type> using enable_if_not_function_holder = typename ::std::enable_if<!is_function_holder<typename ::std::decay<Type>::type>::value>::type;
+template<class Type> using enable_if_not_function_holder = typename ::std::enable_if<!is_function_holder<typename ::std::decay<Type>::type>::value && !is_in_place_type<typename ::std::decay<Type>::type>::value>::type;
+
+/** Check if a given class can be relocated (i.e. moved then destroyed) with a plain memory copy.
+ * @param Type Type to check, specialize to opt-in other classes
+**/
+template<class Type> class is_trivially_relocatable: public ::std::is_trivially_copyable<Type> {};
+
+/** Functor wrapper marking the wrapped functor as trivially relocatable.
+ * @param Functor Functor class to wrap
+**/
+template<class Functor> class Relocatable final {
+private:
+    Functor functor; // Wrapped functor
+public:
+    /** Copy/move constructor.
+     * @param functor Functor to copy/move
+    **/
+    template<class Type, class = typename ::std::enable_if<::std::is_constructible<Functor, Type&&>::value>::type> explicit Relocatable(Type&& functor): functor(::std::forward<Type>(functor)) {}
+    /** Forward the call to the wrapped functor.
+     * @param ... Arguments to forward
+     * @return Functor return value
+    **/
+    template<class... Args> auto operator()(Args&&... args) -> decltype(functor(::std::forward<Args>(args)...)) {
+        return functor(::std::forward<Args>(args)...);
+    }
+};
+template<class Functor> class is_trivially_relocatable<Relocatable<Functor>>: public ::std::true_type {};
+
+/** Mark a functor as trivially relocatable, i.e. assert it does not store pointers to itself and its move constructor does not have side effects.
+ * @param functor Functor to copy/move
+ * @return Wrapped functor
+**/
+template<class Functor> Relocatable<typename ::std::decay<Functor>::type> relocatable(Functor&& functor) {
+    return Relocatable<typename ::std::decay<Functor>::type>{::std::forward<Functor>(functor)};
+}
+
+/** Member function delegate, holding only the object pointer: the member function is part of the class.
+ * Trivially copyable and destructible, so held by function object holders like standalone functions.
+ * @param Object Object class, possibly const
+ * @param Method Member function pointer type
+ * @param method Member function to call
+**/
+template<class Object, class Method, Method method> class Delegate final {
+private:
+    Object* object; // Object to call the member function on
+public:
+    /** Object constructor.
+     * @param object Object to call the member function on (must outlive the delegate)
+    **/
+    explicit Delegate(Object& object) noexcept: object(&object) {}
+    /** Call the member function on the object.
+     * @param ... Arguments to forward
+     * @return Member function return value
+    **/
+    template<class... Args> auto operator()(Args&&... args) const -> decltype((::std::declval<Object&>().*method)(::std::forward<Args>(args)...)) {
+        return (object->*method)(::std::forward<Args>(args)...);
+    }
+};
+
+/** Reference counted functor wrapper, heap-stored by shared function object holders, and only called as const.
+ * @param Functor Functor class to wrap
+ * @param atomic  Whether the reference count is atomic
+**/
+template<class Functor, bool atomic> class Shared final {
+private:
+    using Count = typename ::std::conditional<atomic, ::std::atomic<size_t>, size_t>::type;
+    Count refs; // Number of holders sharing the instance, minus one
+    Functor functor; // Wrapped functor
+private:
+    /** Increment/decrement the reference count.
+     * @param refs Reference count
+     * @return (Decrement only) Reference count before decrement
+    **/
+    static void increment(size_t& refs) noexcept {
+        ++refs;
+    }
+    static void increment(::std::atomic<size_t>& refs) noexcept {
+        refs.fetch_add(1, ::std::memory_order_relaxed);
+    }
+    static size_t decrement(size_t& refs) noexcept {
+        return refs--;
+    }
+    static size_t decrement(::std::atomic<size_t>& refs) noexcept {
+        return refs.fetch_sub(1, ::std::memory_order_acq_rel);
+    }
+public:
+    /** In-place/copy/move constructor, the copy/move is not shared.
+     * @param ... Functor constructor arguments, or wrapper to copy/move
+    **/
+    template<class... CtorArgs, class = typename ::std::enable_if<::std::is_constructible<Functor, CtorArgs&&...>::value>::type> explicit Shared(CtorArgs&&... args): refs(0), functor(::std::forward<CtorArgs>(args)...) {}
+    Shared(Shared const& other): refs(0), functor(other.functor) {}
+    Shared(Shared&& other): refs(0), functor(::std::move(other.functor)) {}
+    /** Share the instance with one more holder.
+    **/
+    void acquire() noexcept {
+        increment(refs);
+    }
+    /** Stop sharing the instance with one holder.
+     * @return True if it was the last holder (the instance must then be destroyed), false otherwise
+    **/
+    bool release() noexcept {
+        return decrement(refs) == 0;
+    }
+    /** Get the wrapped functor.
+     * @return Wrapped functor
+    **/
+    Functor& get() noexcept {
+        return functor;
+    }
+    /** Forward the call to the wrapped functor, as const.
+     * @param ... Arguments to forward
+     * @return Functor return value
+    **/
+    template<class... Args> auto operator()(Args&&... args) const -> decltype(functor(::std::forward<Args>(args)...)) {
+        return functor(::std::forward<Args>(args)...);
+    }
+};
+
+/** Check if a given class is a reference counted functor wrapper.
+ * @param Type Type to identify
+**/
+template<class Type> class is_shared: public ::std::false_type {};
+template<class Functor, bool atomic> class is_shared<Shared<Functor, atomic>>: public ::std::true_type {};
+
+/** Functor wrapper stored by multi-signature holders, identifying the signatures its invoker table must cover.
+ * @param Functor       Functor class to wrap
+ * @param Signatures... Expected function types, but the first one (see 'overloads_of')
+**/
+template<class Functor, class... Signatures> class Overloaded final {
+private:
+    Functor functor; // Wrapped functor
+public:
+    /** In-place/copy/move constructor.
+     * @param ... Functor constructor arguments
+    **/
+    template<class... CtorArgs, class = typename ::std::enable_if<::std::is_constructible<Functor, CtorArgs&&...>::value>::type> explicit Overloaded(CtorArgs&&... args): functor(::std::forward<CtorArgs>(args)...) {}
+    /** Get the wrapped functor.
+     * @return Wrapped functor
+    **/
+    Functor& get() noexcept {
+        return functor;
+    }
+    /** Forward the call to the wrapped functor.
+     * @param ... Arguments to forward
+     * @return Functor return value
+    **/
+    template<class... Args> auto operator()(Args&&... args) -> decltype(functor(::std::forward<Args>(args)...)) {
+        return functor(::std::forward<Args>(args)...);
+    }
+    template<class... Args> auto operator()(Args&&... args) const -> decltype(static_cast<Functor const&>(functor)(::std::forward<Args>(args)...)) {
+        return functor(::std::forward<Args>(args)...);
+    }
+};
+template<class Functor, class... Signatures> class is_trivially_relocatable<Overloaded<Functor, Signatures...>>: public is_trivially_relocatable<Functor> {};
 
 // ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
 
-/** Functor specialized invoker.
+/** Type of an invoker parameter, forwarding a holder call argument without extra copy/move:
+ * by value for references, scalars and small trivially copyable classes (passed in registers), by r-value reference otherwise.
+ * @param Type Argument type, as declared in the holder signature
+**/
+template<class Type, bool reference = ::std::is_reference<Type>::value> class forward_type { // References as-is, without requiring complete referred types
+public:
+    using type = Type;
+};
+template<class Type> class forward_type<Type, false> {
+public:
+    using type = typename ::std::conditional<::std::is_scalar<Type>::value || (::std::is_trivially_copyable<Type>::value && sizeof(Type) <= 2 * sizeof(void*)), Type, Type&&>::type;
+};
+template<class Type> using forward_t = typename forward_type<Type>::type;
+
+/** Type of an argument passed to each of several calls with the same arguments: as 'forward_t', but values passed by r-value reference are copied for each call (never moved from).
+ * @param Type Argument type, as declared in the holder signature
+**/
+template<class Type> using broadcast_t = typename ::std::conditional<::std::is_rvalue_reference<forward_t<Type>>::value, typename ::std::decay<Type>::type, forward_t<Type>>::type;
+
+/** Type of an invoker, i.e. a function calling a functor instance with the forwarded call arguments.
+ * @param Return  Return type
+ * @param Args... Argument types, as declared in the holder signature
+**/
+template<class Return, class... Args> using invoker_t = Return (*)(void*, forward_t<Args>...);
+
+/** Functor specialized invokers, for a locally-stored and a heap-stored functor.
  * @param Functor  Actual functor class
  * @param Return   Return type
  * @param Args...  Argument types
- * @param instance Functor instance
+ * @param instance Functor instance/pointer to the functor instance pointer
  * @param ...      Arguments to forward
  * @return Functor return value
 **/
-template<class Functor, class Return, class... Args> static Return specialized_invoker(void* instance, Args... args) {
+template<class Functor, class Return, class... Args> Return specialized_invoker(void* instance, forward_t<Args>... args) {
     return (*reinterpret_cast<Functor*>(instance))(::std::forward<Args>(args)...);
 }
+template<class Functor, class Return, class... Args> Return specialized_remote_invoker(void* instance, forward_t<Args>... args) {
+    return (**reinterpret_cast<Functor**>(instance))(::std::forward<Args>(args)...);
+}
+
+/** Type of the hook called by empty holders, for the 'ANYFUNCTION_EMPTY_CALL_HOOK' empty call policy.
+**/
+using EmptyCallHook = void (*)();
+
+/** Get the empty call hook storage.
+ * @return Empty call hook (nullptr if none)
+**/
+inline ::std::atomic<EmptyCallHook>& empty_call_hook() noexcept {
+    static ::std::atomic<EmptyCallHook> hook{nullptr};
+    return hook;
+}
+
+/** Set the hook called by empty holders, for the 'ANYFUNCTION_EMPTY_CALL_HOOK' empty call policy.
+ * @param hook Hook to call (nullptr for none), may not return (e.g. log then abort, or throw)
+ * @return Previous hook (nullptr if none)
+**/
+inline EmptyCallHook set_empty_call_hook(EmptyCallHook hook) noexcept {
+    return empty_call_hook().exchange(hook);
+}
+
+/** No functor invoker, i.e. the invoker of empty holders, behaving as selected by 'ANYFUNCTION_EMPTY_CALL'.
+ * @param Return  Return type
+ * @param Args... Argument types
+ * @return Value-initialized value with the 'ANYFUNCTION_EMPTY_CALL_DEFAULT' policy, never returns otherwise
+**/
+template<class Return, class... Args> Return empty_invoker(void*, forward_t<Args>...) {
+#if ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_DEFAULT
+    return Return();
+#elif ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_UNCHECKED
+    assert(false && "anyfunction: no function to call");
+#if defined(__GNUC__)
+    __builtin_unreachable();
+#elif defined(_MSC_VER)
+    __assume(0);
+#else
+    ::std::abort();
+#endif
+#elif ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_HOOK
+    auto hook = empty_call_hook().load(::std::memory_order_acquire);
+    if (hook)
+        hook();
+    ::std::abort();
+#elif ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_ABORT
+    ::std::abort();
+#else
+    throw Exception::Empty();
+#endif
+}
 
-/** Functor manager commands.
+/** Invoker table of multi-signature holders, one pair of invokers per signature.
+ * @param Signatures... Expected function types
 **/
-enum class Command {
-    copy_allocate,  // Allocate and copy constructor
-    copy_construct, // Copy constructor
-    move_allocate,  // Allocate and move constructor
-    move_construct, // Move constructor
-    destroy, // Destroy instance
-    free,    // Delete instance
-    type_size, // Get instance size
-    type_align // Get instance alignment
+template<class... Signatures> struct OverloadTable {};
+template<class Return, class... Args, class... Signatures> struct OverloadTable<Return(Args...), Signatures...> {
+    invoker_t<Return, Args...> local;  // Invoker of a locally-stored instance
+    invoker_t<Return, Args...> remote; // Invoker of a heap-stored instance (given a pointer to the instance pointer)
+    OverloadTable<Signatures...> next; // Invokers of the next signatures
+    /** Get the invokers of a given signature, i.e. the (unique) sub-table starting with it.
+     * @param Table Sub-table class
+     * @return Sub-table
+    **/
+    constexpr OverloadTable const& get(OverloadTable const*) const noexcept {
+        return *this;
+    }
+    template<class Table> constexpr Table const& get(Table const* tag) const noexcept {
+        return next.get(tag);
+    }
 };
 
-/** Function manager return value.
+/** Functor specialized invoker table.
+ * @param Functor       Actual functor class
+ * @param Signatures... Expected function types
 **/
-union ManagerReturn {
+template<class Functor, class... Signatures> class specialized_overloads {
 public:
-    void*  ptr;
-    size_t value;
+    constexpr static OverloadTable<> make() noexcept {
+        return {};
+    }
+};
+template<class Functor, class Return, class... Args, class... Signatures> class specialized_overloads<Functor, Return(Args...), Signatures...> {
+private:
+    using ResultOf = typename ::std::result_of<Functor(Args...)>::type; // Since C++14, not defined if function can not be called with the arguments
+    static_assert(::std::is_same<Return, ResultOf>::value || ::std::is_base_of<Return, ResultOf>::value, "'Functor' result type is incompatible"); // '::std::is_same' needed for fundamental types
 public:
-    /** Pointer constructor.
-     * @param ptr Any pointer, or nullptr
-    **/
-    ManagerReturn(::std::nullptr_t): ptr(nullptr) {}
-    ManagerReturn(void* ptr): ptr(ptr) {}
-    /** Value constructor.
-     * @param ptr Any pointer
-    **/
-    ManagerReturn(size_t value): value(value) {}
+    constexpr static OverloadTable<Return(Args...), Signatures...> make() noexcept {
+        return {specialized_invoker<Functor, Return, Args...>, specialized_remote_invoker<Functor, Return, Args...>, specialized_overloads<Functor, Signatures...>::make()};
+    }
+    constexpr static OverloadTable<Return(Args...), Signatures...> value = {specialized_invoker<Functor, Return, Args...>, specialized_remote_invoker<Functor, Return, Args...>, specialized_overloads<Functor, Signatures...>::make()};
+};
+template<class Functor, class Return, class... Args, class... Signatures> constexpr OverloadTable<Return(Args...), Signatures...> specialized_overloads<Functor, Return(Args...), Signatures...>::value;
+
+/** Get the invoker table of the other signatures of a functor stored by a multi-signature holder.
+ * @param Functor Actual functor class
+**/
+template<class Functor> class overloads_of {
+public:
+    constexpr static void const* value = nullptr;
+};
+template<class Functor, class... Signatures> class overloads_of<Overloaded<Functor, Signatures...>> {
+public:
+    constexpr static void const* value = &specialized_overloads<Overloaded<Functor, Signatures...>, Signatures...>::value;
+};
+template<class Functor, class... Signatures, bool atomic> class overloads_of<Shared<Overloaded<Functor, Signatures...>, atomic>> {
+public:
+    constexpr static void const* value = &specialized_overloads<Shared<Overloaded<Functor, Signatures...>, atomic>, Signatures...>::value;
+};
+
+/** Functor operations table (i.e. functor manager).
+ * @param Invoker Invoker function pointer type
+**/
+template<class Invoker> struct Operations {
+    size_t size;  // Instance size
+    size_t align; // Instance alignment
+    bool nothrow_move; // Move constructor does not throw
+    bool relocatable;  // Trivially relocatable (see 'is_trivially_relocatable')
+    bool trivially_copyable;     // Copy constructor is a plain memory copy
+    bool trivially_destructible; // Destructor does nothing
+    bool shared; // Reference counted, never stored locally (see 'Shared')
+    Invoker local_invoker;  // Invoker of a locally-stored instance
+    Invoker remote_invoker; // Invoker of a heap-stored instance (given a pointer to the instance pointer)
+    TypeId type; // Identity of the user functor class, i.e. without the library wrappers (see 'specialized_target')
+    void* (*target)(void* instance); // Get the user functor instance from the stored one (nullptr if not wrapped)
+    void const* overloads;  // Invoker table of the other signatures (see 'OverloadTable', nullptr unless stored by a multi-signature holder)
+    void* (*copy_allocate)(void const* other); // Allocate and copy constructor (nullptr if move-only)
+    void (*copy_construct)(void* instance, void const* other); // Copy constructor (nullptr if move-only)
+    void* (*move_allocate)(void* other); // Allocate and move constructor
+    void (*move_construct)(void* instance, void* other); // Move constructor
+    void (*destroy)(void* instance); // Destroy instance
+    void (*free)(void* instance); // Delete instance
+    void (*acquire)(void* instance); // Share instance with one more holder (nullptr if not shared)
+    bool (*release)(void* instance); // Stop sharing instance with one holder, true if it was the last one (nullptr if not shared)
 };
 
-/** Functor specialized manager.
+/** Functor specialized copy operations.
  * @param Functor  Actual functor class
- * @param instance Functor instance
- * @param command  Command to execute
- * @param other    Other optional instance
- * @return Optional pointer or value
-**/
-template<class Functor> static ManagerReturn specialized_manager(void* instance, Command command, void* other) {
-    switch (command) {
-        case Command::copy_allocate:
-            return new Functor(*reinterpret_cast<Functor const*>(other));
-        case Command::copy_construct:
-            new(instance) Functor(*reinterpret_cast<Functor const*>(other));
-            break;
-        case Command::move_allocate:
-            return new Functor(::std::move(*reinterpret_cast<Functor*>(other)));
-        case Command::move_construct:
-            new(instance) Functor(::std::move(*reinterpret_cast<Functor*>(other)));
-            break;
-        case Command::destroy:
-            reinterpret_cast<Functor*>(instance)->~Functor();
-            break;
-        case Command::free:
-            delete reinterpret_cast<Functor*>(instance);
-            break;
-        case Command::type_size:
-            return sizeof(Functor);
-        case Command::type_align:
-            return alignof(Functor);
+ * @param copyable Whether copy operations are supported (they are nullptr otherwise)
+**/
+template<class Functor, bool copyable> class specialized_copy {
+public:
+    static void* allocate(void const* other) {
+        return new Functor(*reinterpret_cast<Functor const*>(other));
     }
-    return nullptr;
-}
+    static void construct(void* instance, void const* other) {
+        new(instance) Functor(*reinterpret_cast<Functor const*>(other));
+    }
+};
+template<class Functor> class specialized_copy<Functor, false> {
+public:
+    constexpr static void* (*allocate)(void const*) = nullptr;
+    constexpr static void (*construct)(void*, void const*) = nullptr;
+};
 
-// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+/** Functor specialized move/destroy operations.
+ * @param Functor Actual functor class
+**/
+template<class Functor> class specialized_move {
+public:
+    static void* allocate(void* other) {
+        return new Functor(::std::move(*reinterpret_cast<Functor*>(other)));
+    }
+    static void construct(void* instance, void* other) {
+        new(instance) Functor(::std::move(*reinterpret_cast<Functor*>(other)));
+    }
+    static void destroy(void* instance) {
+        reinterpret_cast<Functor*>(instance)->~Functor();
+    }
+    static void free(void* instance) {
+        delete reinterpret_cast<Functor*>(instance);
+    }
+};
+
+/** Functor specialized sharing operations.
+ * @param Functor Actual functor class
+**/
+template<class Functor> class specialized_share {
+public:
+    constexpr static void (*acquire)(void*) = nullptr;
+    constexpr static bool (*release)(void*) = nullptr;
+};
+template<class Functor, bool atomic> class specialized_share<Shared<Functor, atomic>> {
+public:
+    static void acquire(void* instance) {
+        reinterpret_cast<Shared<Functor, atomic>*>(instance)->acquire();
+    }
+    static bool release(void* instance) {
+        return reinterpret_cast<Shared<Functor, atomic>*>(instance)->release();
+    }
+};
+
+/** Functor specialized user functor access, i.e. unwrapping the library wrappers.
+ * @param Functor Actual functor class
+**/
+template<class Functor> class specialized_target {
+public:
+    using Type = Functor; // User functor class
+    static void* unwrap(void* instance) noexcept {
+        return instance;
+    }
+    constexpr static void* (*get)(void*) = nullptr; // Not wrapped
+};
+template<class Functor, bool atomic> class specialized_target<Shared<Functor, atomic>> {
+public:
+    using Type = typename specialized_target<Functor>::Type;
+    static void* unwrap(void* instance) noexcept {
+        return specialized_target<Functor>::unwrap(&reinterpret_cast<Shared<Functor, atomic>*>(instance)->get());
+    }
+    constexpr static void* (*get)(void*) = unwrap;
+};
+template<class Functor, class... Signatures> class specialized_target<Overloaded<Functor, Signatures...>> {
+public:
+    using Type = Functor;
+    static void* unwrap(void* instance) noexcept {
+        return &reinterpret_cast<Overloaded<Functor, Signatures...>*>(instance)->get();
+    }
+    constexpr static void* (*get)(void*) = unwrap;
+};
 
-/** Possible holder status.
+/** Functor specialized operations table.
+ * @param Functor  Actual functor class
+ * @param copyable Whether copy operations are supported
+ * @param Return   Return type
+ * @param Args...  Argument types
 **/
-enum class Status {
-    invalid,    // No functor
-    standalone, // Standalone function (no storage)
-    local,      // Locally-stored functor
-    remote      // Heap-stored functor
+template<class Functor, bool copyable, class Return, class... Args> class specialized_operations {
+public:
+    constexpr static Operations<invoker_t<Return, Args...>> value = {
+        sizeof(Functor), alignof(Functor),
+        ::std::is_nothrow_move_constructible<Functor>::value, is_trivially_relocatable<Functor>::value,
+        ::std::is_trivially_copyable<Functor>::value, ::std::is_trivially_destructible<Functor>::value, is_shared<Functor>::value,
+        specialized_invoker<Functor, Return, Args...>, specialized_remote_invoker<Functor, Return, Args...>,
+        type_id<typename specialized_target<Functor>::Type>(), specialized_target<Functor>::get, overloads_of<Functor>::value,
+        specialized_copy<Functor, copyable>::allocate, specialized_copy<Functor, copyable>::construct,
+        specialized_move<Functor>::allocate, specialized_move<Functor>::construct,
+        specialized_move<Functor>::destroy, specialized_move<Functor>::free,
+        specialized_share<Functor>::acquire, specialized_share<Functor>::release
+    };
 };
+template<class Functor, bool copyable, class Return, class... Args> constexpr Operations<invoker_t<Return, Args...>> specialized_operations<Functor, copyable, Return, Args...>::value;
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
 
 /** Function object holder template class.
- * @param Return(Args...)    Expected function type.
- * @param local_storage_size Size reserved for the local storage (in bytes, optional)
+ * @param Return(Args...)     Expected function type.
+ * @param local_storage_size  Size reserved for the local storage (in bytes, optional)
+ * @param Policy              Holder policy (optional)
+ * @param local_storage_align Alignment of the local storage, and so of the holder (in bytes, optional)
 **/
-template<class Return, class... Args, size_t local_storage_size> class Function<Return(Args...), local_storage_size> {
-    template<class, size_t> friend class Function;
+template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align> class alignas(void*) alignas(local_storage_align) Function<Return(Args...), local_storage_size, Policy, local_storage_align> {
+    template<class, size_t, class, size_t> friend class Function;
+    template<class> friend class FunctionRef;
+    template<class, size_t, class, size_t> friend class AtomicFunction;
+    friend class Batch;
 protected:
     /** Types of function/helpers used.
     **/
-    using Standalone = Return (*)(Args...);
-    using Invoker = Return (*)(void*, Args...);
-    using Manager = ManagerReturn (*)(void*, Command, void*);
-protected:
-    Status status; // Holder status
-    union {
-        struct {
-            Invoker invoker; // Functor invoker function
-            Manager manager; // Functor manager function
-            void* instance; // Functor instance
-            uint8_t storage[local_storage_size]; // Local storage
-        };
-        Standalone function; // Standalone function
-    };
-private:
-    /** For functors, try "allocating" structure on local storage.
-     * @param Functor/manager Actual functor class (so not a forwarding reference)/specialized manager to use
-     * @return Pointer to the local storage if fits, nullptr otherwise
-    **/
-    void* do_local_alloc(size_t size, size_t align) const noexcept {
-        uintptr_t local = reinterpret_cast<uintptr_t>(storage); // Local storage address
-        uintptr_t delta = (-(local % align)) % align; // Delta for alignment (works since alignof(Functor) divides 2^(8*sizeof(uintptr_t)))
-        if (size + delta > local_storage_size) // Do not fit into local storage
-            return nullptr;
-        return reinterpret_cast<void*>(local + delta);
+    using Standalone = Return (*)(Args...);
+    using Invoker = invoker_t<Return, Args...>;
+    using Manager = Operations<Invoker> const*;
+    /** Local storage, at the beginning of the holder (so aligned as the holder).
+    **/
+    union Storage {
+        Standalone function; // Standalone function (stored as a functor)
+        void* remote; // Heap-stored functor instance
+        uint8_t bytes[local_storage_size]; // Locally-stored functor instance
+    };
+    constexpr static uintptr_t remote_tag = 1; // Manager pointer tag of heap-stored functors (manager tables are at least aligned as a pointer)
+    constexpr static uintptr_t trivial_tag = 2; // Manager pointer tag of locally-stored, trivially copyable and destructible functors (e.g. standalone functions and delegates)
+public:
+    constexpr static size_t capacity = sizeof(Storage); // Actual size of the local storage (at least 'local_storage_size' and a pointer)
+    constexpr static size_t alignment = local_storage_align > alignof(void*) ? local_storage_align : alignof(void*); // Actual alignment of the local storage
+    /** Tell whether a functor would be stored locally (see 'fits_inline').
+     * @param Functor Actual functor class (so not a forwarding reference)
+     * @return True if stored locally, false if heap-stored
+    **/
+    template<class Functor> constexpr static bool fits_local() noexcept {
+        return !is_shared<Functor>::value && (::std::is_nothrow_move_constructible<Functor>::value || is_trivially_relocatable<Functor>::value) && sizeof(Functor) <= capacity && alignof(Functor) <= alignment;
+    }
+protected:
+    Storage storage; // Local storage, holding either the functor instance or the pointer to the heap-stored instance
+    Invoker invoker; // Functor invoker function, always callable (see 'empty_invoker')
+    uintptr_t manager; // Functor manager, tagged with 'remote_tag' if heap-stored or 'trivial_tag' if trivial (0 if no functor)
+    MemoryResource* resource; // Memory resource for heap-stored functors (nullptr for the functor class operators 'new' and 'delete')
+private:
+    /** Enable template overload only if copying/moving from a holder with the given policy is allowed.
+     * @param OtherPolicy Policy of the holder to copy/move
+    **/
+    template<class OtherPolicy> using enable_if_copyable_from = typename ::std::enable_if<OtherPolicy::copyable>::type;
+    template<class OtherPolicy> using enable_if_movable_from = typename ::std::enable_if<!Policy::copyable || OtherPolicy::copyable>::type;
+    /** Type of the copy constructor/assignment parameter: the current class if copyable, an unconstructible class otherwise (copy is then deleted).
+    **/
+    class Uncopyable final {
+        Uncopyable() = delete;
+    };
+    using CopySource = typename ::std::conditional<Policy::copyable, Function, Uncopyable>::type;
+    /** Get the functor manager, whether the functor is heap-stored, and the functor instance.
+     * @return Functor manager (nullptr if no functor)/true if heap-stored/functor instance
+    **/
+    Manager get_manager() const noexcept {
+        return reinterpret_cast<Manager>(manager & ~(remote_tag | trivial_tag));
+    }
+    bool is_remote() const noexcept {
+        return manager & remote_tag;
+    }
+    void* get_instance() const noexcept {
+        return is_remote() ? storage.remote : const_cast<uint8_t*>(storage.bytes);
+    }
+    /** Set the functor manager and invoker, the functor instance being already in place.
+     * @param manager Specialized manager to use
+     * @param remote  Whether the functor is heap-stored
+    **/
+    void validate(Manager manager, bool remote) noexcept {
+        auto trivial = !remote && manager->trivially_copyable && manager->trivially_destructible;
+        this->manager = reinterpret_cast<uintptr_t>(manager) | (remote ? remote_tag : 0) | (trivial ? trivial_tag : 0);
+        invoker = remote ? manager->remote_invoker : manager->local_invoker;
+    }
+    /** Set the no-functor status, without destroying any held functor.
+    **/
+    void invalidate() noexcept {
+        manager = 0;
+        invoker = empty_invoker<Return, Args...>;
+    }
+    /** Record the placement of the held functor into the holder class statistics, if 'ANYFUNCTION_STATISTICS' is defined.
+     * @param operation Operation that placed the functor
+     * @param allocated Whether a heap block has been allocated for the functor
+    **/
+    void record(Statistics::Operation operation, bool allocated) const noexcept {
+#ifdef ANYFUNCTION_STATISTICS
+        auto manager = get_manager();
+        statistics().record(operation, manager->size, manager->align, manager->nothrow_move || manager->relocatable, is_remote(), allocated);
+#else
+        (void) operation;
+        (void) allocated;
+#endif
+    }
+    /** Tell whether a functor is stored locally.
+     * Only functors that can be moved without throwing are stored locally, and only if they fit the local storage
+     * without any alignment adjustment (they are always at its beginning): so moving a holder to another of the same size never throws.
+     * Shared functors are never stored locally, since their instance is shared between holders.
+     * @param manager Specialized manager to use
+     * @return True if stored locally, false if heap-stored
+    **/
+    static bool fits_local(Manager manager) noexcept {
+        return !manager->shared && (manager->nothrow_move || manager->relocatable) && manager->size <= capacity && manager->align <= alignment;
+    }
+    /** Tell whether the functor of another holder is trivial (see 'trivial_tag') and fits the local storage, without reading its manager.
+     * @param func Functor holder to copy/move from
+     * @return True if it can be copied with 'local_copy(func)', false otherwise
+    **/
+    template<class Other> bool trivial_from(Other const& func) const noexcept {
+        return sizeof(func.storage) <= sizeof(storage) && Other::alignment <= alignment && (func.manager & trivial_tag);
+    }
+    /** For locally-stored, trivially copyable/relocatable functors, copy the instance from another holder with a plain memory copy.
+     * Without manager, trivial functors are copied along with the invoker and the tagged manager of the other holder.
+     * @param func    Functor holder to copy from
+     * @param manager Specialized manager to use
+    **/
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // Copied storage bytes can be padding or unused
+#endif
+    template<class Other> void local_copy(Other const& func, Manager manager) noexcept {
+        if (sizeof(func.storage) <= sizeof(storage)) // Whole storage copy, of constant size
+            ::std::memcpy(&storage, &func.storage, sizeof(func.storage));
+        else
+            ::std::memcpy(&storage, &func.storage, manager->size);
+    }
+    template<class Other> void local_copy(Other const& func) noexcept {
+        ::std::memcpy(&storage, &func.storage, sizeof(func.storage));
+        invoker = func.invoker;
+        manager = func.manager;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    /** For functors, allocate then copy/move construct structure on the heap, through the memory resource (if any).
+     * @param manager Specialized manager to use
+     * @param other   Functor instance to copy/move
+     * @return Pointer to the heap-stored functor
+    **/
+    void* remote_copy(Manager manager, void const* other) {
+        if (!resource) // Functor class operators 'new' and 'delete'
+            return manager->copy_allocate(other); // Can throw
+        auto ptr = resource->allocate(manager->size, manager->align); // Can throw
+        ANYFUNCTION_TRY {
+            manager->copy_construct(ptr, other);
+        } ANYFUNCTION_CATCH_ALL { // Release block, then forward exception
+            resource->deallocate(ptr, manager->size, manager->align);
+            ANYFUNCTION_RETHROW;
+        }
+        return ptr;
     }
-    template<class Functor> void* local_alloc() const noexcept {
-        return do_local_alloc(sizeof(Functor), alignof(Functor));
+    void* remote_move(Manager manager, void* other) {
+        if (!resource) // Functor class operators 'new' and 'delete'
+            return manager->move_allocate(other); // Can throw
+        auto ptr = resource->allocate(manager->size, manager->align); // Can throw
+        ANYFUNCTION_TRY {
+            manager->move_construct(ptr, other);
+        } ANYFUNCTION_CATCH_ALL { // Release block, then forward exception
+            resource->deallocate(ptr, manager->size, manager->align);
+            ANYFUNCTION_RETHROW;
+        }
+        return ptr;
     }
-    void* local_alloc(Manager manager) const noexcept {
-        return do_local_alloc(manager(nullptr, Command::type_size, nullptr).value, manager(nullptr, Command::type_align, nullptr).value);
+    /** For functors, destroy then free structure on the heap, through the memory resource (if any), unless still shared with other holders.
+     * @param manager Specialized manager to use
+     * @param ptr     Pointer to the heap-stored functor
+    **/
+    void remote_free(Manager manager, void* ptr) {
+        if (manager->shared && !manager->release(ptr)) // Still used by other holders
+            return;
+        if (!resource) { // Functor class operators 'new' and 'delete'
+            manager->free(ptr); // Can throw
+            return;
+        }
+        if (!manager->trivially_destructible)
+            manager->destroy(ptr); // Can throw
+        resource->deallocate(ptr, manager->size, manager->align);
     }
 protected:
     /** Copy functor via manager.
      * @param func Functor holder to copy
     **/
-    template<size_t other_storage_size> void via_manager(Function<Return(Args...), other_storage_size> const& func) {
-        switch (func.status) {
-            case Status::invalid:
-                break;
-            case Status::standalone:
-                function = func.function;
-                status = Status::standalone;
-                break;
-            case Status::local:
-            case Status::remote: {
-                auto ptr = local_alloc(func.manager);
-                if (ptr) { // Local allocation done
-                    func.manager(ptr, Command::copy_construct, func.instance); // Can throw
-                    instance = ptr;
-                    status = Status::local;
-                } else { // Heap allocation to do
-                    instance = func.manager(nullptr, Command::copy_allocate, func.instance).ptr; // Can throw
-                    status = Status::remote;
-                }
-                invoker = func.invoker;
-                manager = func.manager;
-            } break;
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align> void via_manager(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align> const& func) {
+        static_assert(OtherPolicy::copyable, "Can not copy from a move-only function holder");
+        if (trivial_from(func)) { // Plain copy of the storage, invoker and tagged manager
+            local_copy(func);
+            record(Statistics::Operation::copy, false);
+            return;
+        }
+        auto manager = func.get_manager();
+        if (!manager) // No functor
+            return;
+        if (!fits_local(manager)) {
+            if (!Policy::heap) // Heap-free holder
+                Exception::raise<Exception::Overflow>();
+            auto share = manager->shared && func.is_remote() && same_resource(resource, func.resource);
+            if (share) { // Just share instance, if allocated from an interchangeable memory resource
+                manager->acquire(func.storage.remote);
+                storage.remote = func.storage.remote;
+            } else { // Heap allocation to do
+                storage.remote = remote_copy(manager, func.get_instance()); // Can throw
+            }
+            validate(manager, true);
+            record(Statistics::Operation::copy, !share);
+            return;
+        }
+        if (manager->trivially_copyable && !func.is_remote()) { // Plain memory copy
+            local_copy(func, manager);
+        } else {
+            manager->copy_construct(storage.bytes, func.get_instance()); // Can throw
         }
+        validate(manager, false);
+        record(Statistics::Operation::copy, false);
     }
     /** Move functor via manager.
-     * @param func Functor holder to move
+     * @param func Functor holder to move; if no exception occurs, gets invalidated
     **/
-    template<size_t other_storage_size> void via_manager(Function<Return(Args...), other_storage_size>&& func) {
-        switch (func.status) {
-            case Status::invalid:
-                break;
-            case Status::standalone:
-                function = func.function;
-                status = Status::standalone;
-                func.status = Status::invalid; // Other function holder is then invalid (for consistency with other status)
-                break;
-            case Status::local: {
-                auto ptr = local_alloc(func.manager);
-                if (ptr) { // Local allocation done
-                    func.manager(ptr, Command::move_construct, func.instance); // Can throw
-                    instance = ptr;
-                    status = Status::local;
-                } else { // Heap allocation to do
-                    instance = func.manager(nullptr, Command::move_allocate, func.instance).ptr; // Can throw
-                    status = Status::remote;
-                }
-                invoker = func.invoker;
-                manager = func.manager;
-                func.clear(); // Other function holder is then invalid
-            } break;
-            case Status::remote: { // Just take over instance
-                instance = func.instance;
-                status = Status::remote;
-                invoker = func.invoker;
-                manager = func.manager;
-                func.status = Status::invalid; // Other function holder is then invalid
-            } break;
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align> void via_manager(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align>&& func) {
+        static_assert(!Policy::copyable || OtherPolicy::copyable, "Can not move from a move-only function holder to a copyable one");
+        if (trivial_from(func)) { // Plain copy of the storage, invoker and tagged manager
+            local_copy(func);
+            record(Statistics::Operation::move, false);
+            func.invalidate(); // Other function holder is then invalid
+            return;
+        }
+        auto manager = func.get_manager();
+        if (!manager) // No functor
+            return;
+        if (Policy::heap && func.is_remote() && same_resource(resource, func.resource)) { // Just take over instance, if allocated from an interchangeable memory resource (heap-free holders never own a heap block)
+            storage.remote = func.storage.remote;
+            validate(manager, true);
+            record(Statistics::Operation::move, false);
+            func.invalidate(); // Other function holder is then invalid
+            return;
         }
+        if (!fits_local(manager)) { // Heap allocation to do
+            if (!Policy::heap) // Heap-free holder
+                Exception::raise<Exception::Overflow>();
+            if (manager->shared) { // Instance possibly used by other holders, so copied
+                storage.remote = remote_copy(manager, func.get_instance()); // Can throw
+            } else {
+                storage.remote = remote_move(manager, func.get_instance()); // Can throw
+            }
+            validate(manager, true);
+            record(Statistics::Operation::move, true);
+            func.clear(); // Other function holder is then invalid
+            return;
+        }
+        if (manager->relocatable && !func.is_remote()) { // Just relocate the functor
+            local_copy(func, manager);
+            validate(manager, false);
+            record(Statistics::Operation::move, false);
+            func.invalidate(); // Other function holder is then invalid (its functor has been relocated, not copied)
+            return;
+        }
+        manager->move_construct(storage.bytes, func.get_instance()); // Can throw
+        validate(manager, false);
+        record(Statistics::Operation::move, false);
+        func.clear(); // Other function holder is then invalid
     }
     /** Copy/move functor via class.
      * @param functor Functor to copy/move
     **/
     template<class Type> void via_class(Type&& functor) {
-        using Functor = typename ::std::decay<Type>::type;
+        via_emplace<typename ::std::decay<Type>::type>(::std::forward<Type>(functor));
+    }
+    /** Construct functor in place, in the local storage or directly in the heap-allocated block.
+     * @param Functor Functor class to construct
+     * @param ...     Functor constructor arguments
+    **/
+    template<class Functor, class... CtorArgs> void via_emplace(CtorArgs&&... args) {
+        static_assert(::std::is_same<Functor, typename ::std::decay<Functor>::type>::value, "'Functor' must be a non-reference, non-const class");
         { // Check functor callability
             using ResultOf = typename ::std::result_of<Functor(Args...)>::type; // Since C++14, not defined if function can not be called with the arguments
             static_assert(::std::is_same<Return, ResultOf>::value || ::std::is_base_of<Return, ResultOf>::value, "'Functor' result type is incompatible"); // '::std::is_same' needed for fundamental types
         }
-        auto ptr = local_alloc<Functor>();
-        if (ptr) { // Local allocation done
-            new(ptr) Functor(::std::forward<Type>(functor)); // Can throw
-            instance = ptr;
-            status = Status::local;
-        } else { // Heap allocation to do
-            instance = new Functor(::std::forward<Type>(functor)); // Can throw
-            status = Status::remote;
+        static_assert(!Policy::copyable || ::std::is_copy_constructible<Functor>::value, "'Functor' is not copyable, use a move-only function holder");
+        static_assert(!Policy::shared || Policy::copyable, "Shared function holders must be copyable");
+        static_assert(!Policy::shared || Policy::heap, "Shared function holders must be allowed to use the heap");
+        if (Policy::shared) { // Check functor const callability, as shared functors are only called as const
+            using ResultOf = typename ::std::result_of<typename ::std::conditional<Policy::shared, Functor const&, Functor>::type(Args...)>::type;
+            static_assert(::std::is_same<Return, ResultOf>::value || ::std::is_base_of<Return, ResultOf>::value, "'Functor' result type is incompatible when called as const");
+        }
+        using Stored = typename ::std::conditional<Policy::shared && !fits_local<Functor>(), Shared<Functor, Policy::atomic_refs>, Functor>::type; // Heap-stored functors of shared holders are reference counted
+        static_assert(Policy::heap || fits_local<Stored>(), "'Functor' does not fit in the local storage (too large, too aligned or its move constructor could throw), use a larger storage or a holder allowed to use the heap");
+        Manager manager = &specialized_operations<Stored, Policy::copyable, Return, Args...>::value;
+        if (fits_local<Stored>()) { // Local construction, placement resolved at compile time
+            new(storage.bytes) Stored(::std::forward<CtorArgs>(args)...); // Can throw
+            validate(manager, false);
+            record(Statistics::Operation::construct, false);
+        } else if (!resource) { // Heap allocation to do, with the functor class operator 'new'
+            storage.remote = new Stored(::std::forward<CtorArgs>(args)...); // Can throw
+            validate(manager, true);
+            record(Statistics::Operation::construct, true);
+        } else { // Heap allocation to do, through the memory resource
+            auto ptr = resource->allocate(sizeof(Stored), alignof(Stored)); // Can throw
+            ANYFUNCTION_TRY {
+                new(ptr) Stored(::std::forward<CtorArgs>(args)...);
+            } ANYFUNCTION_CATCH_ALL { // Release block, then forward exception
+                resource->deallocate(ptr, sizeof(Stored), alignof(Stored));
+                ANYFUNCTION_RETHROW;
+            }
+            storage.remote = ptr;
+            validate(manager, true);
+            record(Statistics::Operation::construct, true);
         }
-        invoker = specialized_invoker<Functor, Return, Args...>;
-        manager = specialized_manager<Functor>;
     }
 public:
     /** No functor constructor/assignment.
      * @return Current instance
     **/
-    Function() noexcept: status(Status::invalid) {}
+    Function() noexcept: invoker(empty_invoker<Return, Args...>), manager(0), resource(default_resource()) {}
     Function(::std::nullptr_t) noexcept(noexcept(Function())): Function() {}
     Function& operator=(::std::nullptr_t) {
         clear();
@@ -321,18 +1496,18 @@ public:
      * @param func Function holder to copy
      * @return Current instance
     **/
-    Function(Function<Return(Args...), local_storage_size> const& func): status(Status::invalid) {
+    Function(CopySource const& func): Function(::std::allocator_arg, func.resource) {
         via_manager(func);
     }
-    template<size_t other_storage_size> Function(Function<Return(Args...), other_storage_size> const& func): status(Status::invalid) {
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_copyable_from<OtherPolicy>> Function(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align> const& func): Function(::std::allocator_arg, func.resource) {
         via_manager(func);
     }
-    Function& operator=(Function<Return(Args...), local_storage_size> const& func) {
+    Function& operator=(CopySource const& func) {
         clear();
         via_manager(func);
         return *this;
     }
-    template<size_t other_storage_size> Function& operator=(Function<Return(Args...), other_storage_size> const& func) {
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_copyable_from<OtherPolicy>> Function& operator=(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align> const& func) {
         clear();
         via_manager(func);
         return *this;
@@ -341,18 +1516,18 @@ public:
      * @param func Function holder to move; if no exception occurs, gets invalidated, otherwise left untouched by the holder (so actual exception safety only depends on the functor itself)
      * @return Current instance
     **/
-    Function(Function<Return(Args...), local_storage_size>&& func): status(Status::invalid) {
+    Function(Function&& func) noexcept: Function(::std::allocator_arg, func.resource) {
         via_manager(::std::move(func));
     }
-    template<size_t other_storage_size> Function(Function<Return(Args...), other_storage_size>&& func): status(Status::invalid) {
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_movable_from<OtherPolicy>> Function(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align>&& func): Function(::std::allocator_arg, func.resource) {
         via_manager(::std::move(func));
     }
-    Function& operator=(Function<Return(Args...), local_storage_size>&& func) {
+    Function& operator=(Function&& func) {
         clear();
         via_manager(::std::move(func));
         return *this;
     }
-    template<size_t other_storage_size> Function& operator=(Function<Return(Args...), other_storage_size>&& func) {
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_movable_from<OtherPolicy>> Function& operator=(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align>&& func) {
         clear();
         via_manager(::std::move(func));
         return *this;
@@ -361,18 +1536,19 @@ public:
      * @param func Standalone function
      * @return Current instance
     **/
-    Function(Standalone func) noexcept: status(Status::standalone), function(func) {}
+    Function(Standalone func) noexcept: Function() {
+        via_class(func); // Always stored locally
+    }
     Function& operator=(Standalone func) {
         clear();
-        function = func;
-        status = Status::standalone;
+        via_class(func);
         return *this;
     }
     /** Functor copy/move constructor/assignment.
      * @param functor Function instance to copy/move
      * @return Current instance
     **/
-    template<class Functor, class = enable_if_not_function_holder<Functor>> Function(Functor&& functor): status(Status::invalid) {
+    template<class Functor, class = enable_if_not_function_holder<Functor>> Function(Functor&& functor): Function() {
         via_class(::std::forward<Functor>(functor));
     }
     template<class Functor, class = enable_if_not_function_holder<Functor>> Function& operator=(Functor&& functor) {
@@ -380,51 +1556,616 @@ public:
         via_class(::std::forward<Functor>(functor));
         return *this;
     }
+    /** Functor in-place constructor/assignment.
+     * @param Functor Functor class to construct
+     * @param ...     Functor constructor arguments
+    **/
+    template<class Functor, class... CtorArgs> explicit Function(in_place_type_t<Functor>, CtorArgs&&... args): Function() {
+        via_emplace<Functor>(::std::forward<CtorArgs>(args)...);
+    }
+    template<class Functor, class... CtorArgs> void emplace(CtorArgs&&... args) {
+        clear();
+        via_emplace<Functor>(::std::forward<CtorArgs>(args)...);
+    }
+    /** Make a holder of a delegate, calling a member function on an object (see 'Delegate'), copied and destroyed like a standalone function.
+     * @param Method Member function pointer type (implied with C++17)
+     * @param method Member function to call
+     * @param object Object to call the member function on (must outlive the holder)
+     * @return Function object holder
+    **/
+    template<class Method, Method method, class Object> static Function bind(Object& object) noexcept {
+        return Function{in_place_type<Delegate<Object, Method, method>>, object};
+    }
+    template<class Method, Method method, class Object> static Function bind(Object const&&) = delete;
+#if __cplusplus >= 201703L
+    template<auto method, class Object> static Function bind(Object& object) noexcept {
+        return bind<decltype(method), method>(object);
+    }
+    template<auto method, class Object> static Function bind(Object const&&) = delete;
+#endif
+    /** Memory resource constructors, the given resource is kept by the holder for its whole lifetime.
+     * @param resource Memory resource to use for heap-stored functors (nullptr for the functor class operators 'new' and 'delete')
+     * @param func     Function holder to copy/move, or standalone function, or functor to copy/move
+    **/
+    Function(::std::allocator_arg_t, MemoryResource* resource) noexcept: invoker(empty_invoker<Return, Args...>), manager(0), resource(resource) {}
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_copyable_from<OtherPolicy>> Function(::std::allocator_arg_t, MemoryResource* resource, Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align> const& func): Function(::std::allocator_arg, resource) {
+        via_manager(func);
+    }
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align, class = enable_if_movable_from<OtherPolicy>> Function(::std::allocator_arg_t, MemoryResource* resource, Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align>&& func): Function(::std::allocator_arg, resource) {
+        via_manager(::std::move(func));
+    }
+    Function(::std::allocator_arg_t, MemoryResource* resource, Standalone func) noexcept: Function(::std::allocator_arg, resource) {
+        via_class(func); // Always stored locally
+    }
+    template<class Functor, class = enable_if_not_function_holder<Functor>> Function(::std::allocator_arg_t, MemoryResource* resource, Functor&& functor): Function(::std::allocator_arg, resource) {
+        via_class(::std::forward<Functor>(functor));
+    }
+    template<class Functor, class... CtorArgs> Function(::std::allocator_arg_t, MemoryResource* resource, in_place_type_t<Functor>, CtorArgs&&... args): Function(::std::allocator_arg, resource) {
+        via_emplace<Functor>(::std::forward<CtorArgs>(args)...);
+    }
     /** Clear destructor.
     **/
     ~Function() {
         clear();
     }
 public:
+#ifdef ANYFUNCTION_STATISTICS
+    /** Get the closure placement statistics of the holder class, registered on first use (see 'Statistics::for_each').
+     * @return Holder class statistics
+    **/
+    static Statistics& statistics() noexcept {
+#ifdef __GNUC__
+        static Statistics stats{__PRETTY_FUNCTION__, capacity, alignment};
+#else
+        static Statistics stats{"?", capacity, alignment};
+#endif
+        return stats;
+    }
+#endif
+    /** Get the memory resource used for heap-stored functors.
+     * @return Memory resource in use (nullptr for the functor class operators 'new' and 'delete')
+    **/
+    MemoryResource* get_resource() const noexcept {
+        return resource;
+    }
     /** Tell whether a functor is held, and so is callable.
      * @return True if held a functor, false otherwise
     **/
     operator bool() const noexcept {
-        return status != Status::invalid;
+        return manager != 0;
+    }
+    /** Get the identity of the held functor class, without RTTI.
+     * @return Functor class identity (none if no functor)
+    **/
+    TypeId target_type() const noexcept {
+        auto manager = get_manager();
+        return manager ? manager->type : TypeId{};
+    }
+    /** Get the held functor instance, if of the given class; shared instances are only accessible as const.
+     * @param Functor Expected functor class (a standalone function is held as a function pointer)
+     * @return Pointer to the held functor, nullptr if no functor or not of the given class
+    **/
+    template<class Functor> Functor* target() noexcept {
+        auto manager = get_manager();
+        if (!manager || manager->type != type_id<Functor>() || manager->shared)
+            return nullptr;
+        auto instance = get_instance();
+        return reinterpret_cast<Functor*>(manager->target ? manager->target(instance) : instance);
+    }
+    template<class Functor> Functor const* target() const noexcept {
+        auto manager = get_manager();
+        if (!manager || manager->type != type_id<Functor>())
+            return nullptr;
+        auto instance = get_instance();
+        return reinterpret_cast<Functor const*>(manager->target ? manager->target(instance) : instance);
+    }
+    /** Call the held function with the given parameters, directly (so possibly inlined) if the held functor is of the given class.
+     * @param Functor Expected (hot) functor class
+     * @param ...     Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    template<class Functor> Return invoke_as(Args... args) {
+        auto functor = target<Functor>();
+        if (functor) // Known class, direct call
+            return (*functor)(::std::forward<Args>(args)...);
+        return invoker(&storage, ::std::forward<Args>(args)...);
     }
     /** Call the held function with the given parameters.
      * @param ... Arguments to pass to the function
      * @return Return value of the function
     **/
     Return operator()(Args... args) {
-        switch (status) {
-            case Status::invalid:
-                throw Exception::Empty();
-            case Status::standalone:
-                return function(::std::forward<Args>(args)...);
-            case Status::local:
-            case Status::remote:
-                return invoker(instance, ::std::forward<Args>(args)...);
+        return invoker(&storage, ::std::forward<Args>(args)...);
+    }
+    /** Swap the held functors with another holder, each holder keeps its memory resource.
+     * @param func Function holder to swap with
+    **/
+    void swap(Function& func) {
+        Function temp{::std::move(func)}; // Never throws
+        func = ::std::move(*this);
+        *this = ::std::move(temp);
+    }
+    /** Clear the functor holder to the no-functor status.
+    **/
+    void clear() {
+        if (this->manager & trivial_tag) { // Nothing to destroy
+            invalidate();
+            return;
         }
+        auto manager = get_manager();
+        if (!manager) // No functor
+            return;
+        if (is_remote()) {
+            remote_free(manager, storage.remote); // Delete instance (can throw exception)
+        } else if (!manager->trivially_destructible) {
+            manager->destroy(storage.bytes); // Destroy instance (can throw exception)
+        }
+        invalidate(); // Must happen after destruction, so actual exception safety depends on the functor itself
+    }
+};
+
+/** Swap the held functors of two holders, each holder keeps its memory resource.
+ * @param a First function holder
+ * @param b Second function holder
+**/
+template<class Any, size_t local_storage_size, class Policy, size_t local_storage_align> void swap(Function<Any, local_storage_size, Policy, local_storage_align>& a, Function<Any, local_storage_size, Policy, local_storage_align>& b) {
+    a.swap(b);
+}
+
+/** Make a function object holder, constructing the functor in place.
+ * @param Any                Expected function type
+ * @param local_storage_size Size reserved for the local storage (in bytes, optional)
+ * @param Functor            Functor class to construct
+ * @param ...                Functor constructor arguments
+ * @return Function object holder
+**/
+template<class Any, size_t local_storage_size, class Functor, class... CtorArgs> Function<Any, local_storage_size> make_function(CtorArgs&&... args) {
+    return Function<Any, local_storage_size>{in_place_type<Functor>, ::std::forward<CtorArgs>(args)...};
+}
+template<class Any, class Functor, class... CtorArgs> Function<Any> make_function(CtorArgs&&... args) {
+    return Function<Any>{in_place_type<Functor>, ::std::forward<CtorArgs>(args)...};
+}
+
+/** Check if a given functor would be stored in the local storage of a function object holder.
+ * @param Functor             Functor class to check (decayed)
+ * @param local_storage_size  Size reserved for the local storage (in bytes)
+ * @param local_storage_align Alignment of the local storage (in bytes, optional)
+**/
+template<class Functor, size_t local_storage_size, size_t local_storage_align = alignof(::std::max_align_t)> class fits_inline: public ::std::integral_constant<bool, Function<void(), local_storage_size, DefaultPolicy, local_storage_align>::template fits_local<typename ::std::decay<Functor>::type>()> {};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Call operators of a multi-signature holder but the one of its first signature, invoking through the invoker table.
+ * @param Holder Multi-signature holder class
+ * @param Table  Invoker table of the signatures to provide
+**/
+template<class Holder, class Table> class OverloadCalls;
+template<class Holder, class Return, class... Args> class OverloadCalls<Holder, OverloadTable<Return(Args...)>> {
+public:
+    /** Call the held function with the given parameters.
+     * @param ... Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    Return operator()(Args... args) {
+        auto& holder = static_cast<Holder&>(*this);
+        auto invoker = holder.template get_invoker<OverloadTable<Return(Args...)>>();
+        return (invoker ? invoker : empty_invoker<Return, Args...>)(holder.get_storage(), ::std::forward<Args>(args)...);
+    }
+};
+template<class Holder, class Return, class... Args, class Next, class... Signatures> class OverloadCalls<Holder, OverloadTable<Return(Args...), Next, Signatures...>>: public OverloadCalls<Holder, OverloadTable<Next, Signatures...>> {
+public:
+    using OverloadCalls<Holder, OverloadTable<Next, Signatures...>>::operator();
+    /** Call the held function with the given parameters.
+     * @param ... Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    Return operator()(Args... args) {
+        auto& holder = static_cast<Holder&>(*this);
+        auto invoker = holder.template get_invoker<OverloadTable<Return(Args...), Next, Signatures...>>();
+        return (invoker ? invoker : empty_invoker<Return, Args...>)(holder.get_storage(), ::std::forward<Args>(args)...);
+    }
+};
+
+/** Multi-signature function object holder template class, i.e. one functor callable with several signatures.
+ * The functor is held by a single-signature holder of the first signature (same layout, policy and memory resource handling),
+ * its manager pointing to a per-functor invoker table of the other signatures: calling the first signature costs the same as
+ * with a single-signature holder, calling another one costs one more table lookup.
+ * @param Return(Args...)     First expected function type
+ * @param Signatures...       Other expected function types
+ * @param local_storage_size  Size reserved for the local storage (in bytes, optional)
+ * @param Policy              Holder policy (optional)
+ * @param local_storage_align Alignment of the local storage, and so of the holder (in bytes, optional)
+**/
+template<class Return, class... Args, class Next, class... Signatures, size_t local_storage_size, class Policy, size_t local_storage_align> class Function<Overloads<Return(Args...), Next, Signatures...>, local_storage_size, Policy, local_storage_align>: public OverloadCalls<Function<Overloads<Return(Args...), Next, Signatures...>, local_storage_size, Policy, local_storage_align>, OverloadTable<Next, Signatures...>> {
+    template<class, size_t, class, size_t> friend class Function;
+    template<class, class> friend class OverloadCalls;
+protected:
+    /** Types of holder/helpers used.
+    **/
+    using Holder = Function<Return(Args...), local_storage_size, Policy, local_storage_align>;
+    using Table = OverloadTable<Next, Signatures...>;
+    template<class Functor> using Stored = Overloaded<Functor, Next, Signatures...>;
+public:
+    constexpr static size_t capacity = Holder::capacity; // Actual size of the local storage
+    constexpr static size_t alignment = Holder::alignment; // Actual alignment of the local storage
+    /** Tell whether a functor would be stored locally.
+     * @param Functor Actual functor class (so not a forwarding reference)
+     * @return True if stored locally, false if heap-stored
+    **/
+    template<class Functor> constexpr static bool fits_local() noexcept {
+        return Holder::template fits_local<Stored<Functor>>();
+    }
+protected:
+    Holder holder; // Holder of the functor, for the first signature
+private:
+    /** Get the invoker of a given signature (but the first one), and the pointer to pass to invokers.
+     * @param Sub Invoker sub-table of the signature
+     * @return Invoker of the signature (nullptr if no functor)/pointer to the local storage
+    **/
+    template<class Sub> decltype(Sub::local) get_invoker() noexcept {
+        auto manager = holder.get_manager();
+        if (!manager) // No functor
+            return nullptr;
+        auto& sub = static_cast<Table const*>(manager->overloads)->get(static_cast<Sub const*>(nullptr));
+        return holder.is_remote() ? sub.remote : sub.local;
+    }
+    void* get_storage() noexcept {
+        return &holder.storage;
+    }
+public:
+    /** No functor constructor/assignment.
+     * @return Current instance
+    **/
+    Function() noexcept = default;
+    Function(::std::nullptr_t) noexcept: Function() {}
+    Function& operator=(::std::nullptr_t) {
+        clear();
+        return *this;
+    }
+    /** Function holder copy/move constructor/assignment, copy is deleted for move-only policies.
+     * @param func Function holder to copy/move
+     * @return Current instance
+    **/
+    Function(Function const&) = default;
+    Function(Function&&) noexcept = default;
+    Function& operator=(Function const&) = default;
+    Function& operator=(Function&&) = default;
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align> Function(Function<Overloads<Return(Args...), Next, Signatures...>, other_storage_size, OtherPolicy, other_storage_align> const& func): holder(func.holder) {}
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align> Function(Function<Overloads<Return(Args...), Next, Signatures...>, other_storage_size, OtherPolicy, other_storage_align>&& func): holder(::std::move(func.holder)) {}
+    /** Functor copy/move constructor/assignment.
+     * @param functor Function instance to copy/move
+     * @return Current instance
+    **/
+    template<class Functor, class = enable_if_not_function_holder<Functor>> Function(Functor&& functor): holder(in_place_type<Stored<typename ::std::decay<Functor>::type>>, ::std::forward<Functor>(functor)) {}
+    template<class Functor, class = enable_if_not_function_holder<Functor>> Function& operator=(Functor&& functor) {
+        holder.template emplace<Stored<typename ::std::decay<Functor>::type>>(::std::forward<Functor>(functor));
+        return *this;
+    }
+    /** Functor in-place constructor/assignment.
+     * @param Functor Functor class to construct
+     * @param ...     Functor constructor arguments
+    **/
+    template<class Functor, class... CtorArgs> explicit Function(in_place_type_t<Functor>, CtorArgs&&... args): holder(in_place_type<Stored<Functor>>, ::std::forward<CtorArgs>(args)...) {}
+    template<class Functor, class... CtorArgs> void emplace(CtorArgs&&... args) {
+        holder.template emplace<Stored<Functor>>(::std::forward<CtorArgs>(args)...);
+    }
+    /** Memory resource constructors, the given resource is kept by the holder for its whole lifetime.
+     * @param resource Memory resource to use for heap-stored functors (nullptr for the functor class operators 'new' and 'delete')
+     * @param functor  Functor to copy/move
+    **/
+    Function(::std::allocator_arg_t, MemoryResource* resource) noexcept: holder(::std::allocator_arg, resource) {}
+    template<class Functor, class = enable_if_not_function_holder<Functor>> Function(::std::allocator_arg_t, MemoryResource* resource, Functor&& functor): holder(::std::allocator_arg, resource, in_place_type<Stored<typename ::std::decay<Functor>::type>>, ::std::forward<Functor>(functor)) {}
+    template<class Functor, class... CtorArgs> Function(::std::allocator_arg_t, MemoryResource* resource, in_place_type_t<Functor>, CtorArgs&&... args): holder(::std::allocator_arg, resource, in_place_type<Stored<Functor>>, ::std::forward<CtorArgs>(args)...) {}
+public:
+#ifdef ANYFUNCTION_STATISTICS
+    /** Get the closure placement statistics of the holder class (shared with the single-signature holder of the first signature).
+     * @return Holder class statistics
+    **/
+    static Statistics& statistics() noexcept {
+        return Holder::statistics();
+    }
+#endif
+    /** Get the memory resource used for heap-stored functors.
+     * @return Memory resource in use (nullptr for the functor class operators 'new' and 'delete')
+    **/
+    MemoryResource* get_resource() const noexcept {
+        return holder.get_resource();
+    }
+    /** Tell whether a functor is held, and so is callable.
+     * @return True if held a functor, false otherwise
+    **/
+    operator bool() const noexcept {
+        return static_cast<bool>(holder);
+    }
+    /** Get the identity of the held functor class/the held functor instance, if of the given class (see single-signature holders).
+     * @param Functor Expected functor class
+     * @return Functor class identity (none if no functor)/pointer to the held functor, nullptr if no functor or not of the given class
+    **/
+    TypeId target_type() const noexcept {
+        return holder.target_type();
+    }
+    template<class Functor> Functor* target() noexcept {
+        return holder.template target<Functor>();
+    }
+    template<class Functor> Functor const* target() const noexcept {
+        return holder.template target<Functor>();
+    }
+    /** Call the held function with the given parameters, the other signatures being provided by 'OverloadCalls'.
+     * @param ... Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    using OverloadCalls<Function, Table>::operator();
+    Return operator()(Args... args) {
+        return holder.invoker(&holder.storage, ::std::forward<Args>(args)...);
+    }
+    /** Swap the held functors with another holder, each holder keeps its memory resource.
+     * @param func Function holder to swap with
+    **/
+    void swap(Function& func) {
+        holder.swap(func.holder);
     }
     /** Clear the functor holder to the no-functor status.
     **/
     void clear() {
-        switch (status) {
-            case Status::invalid:
-                break;
-            case Status::standalone:
-                status = Status::invalid;
-                break;
-            case Status::local:
-                manager(instance, Command::destroy, nullptr); // Destroy instance (can throw exception)
-                status = Status::invalid; // Must happen after destruction, so actual exception safety depends on the functor itself
-                break;
-            case Status::remote:
-                manager(instance, Command::free, nullptr); // Delete instance (can throw exception)
-                status = Status::invalid; // Must happen after destruction, so actual exception safety depends on the functor itself
-                break;
+        holder.clear();
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function object reference template class, i.e. a non-owning, two-pointer view of a callable.
+ * @param Return(Args...) Expected function type.
+**/
+template<class Return, class... Args> class FunctionRef<Return(Args...)> final {
+protected:
+    /** Types of function/helpers used.
+    **/
+    using Standalone = Return (*)(Args...);
+    using Invoker = invoker_t<Return, Args...>;
+protected:
+    union {
+        Standalone function; // Standalone function
+        void* instance; // Referred functor instance
+    };
+    Invoker invoker; // Functor invoker function, given a pointer to the union above, always callable (see 'empty_invoker')
+private:
+    /** Enable template overload only if the given type is a functor, neither a function nor a function holder/reference.
+     * @param Type Type to identify
+    **/
+    template<class Type, class Functor = typename ::std::decay<Type>::type> using enable_if_functor = typename ::std::enable_if<!::std::is_function<typename ::std::remove_reference<Type>::type>::value && !is_function_holder<Functor>::value && !::std::is_same<Functor, FunctionRef>::value>::type;
+public:
+    /** No functor constructor.
+    **/
+    FunctionRef() noexcept: instance(nullptr), invoker(empty_invoker<Return, Args...>) {}
+    FunctionRef(::std::nullptr_t) noexcept: FunctionRef() {}
+    /** Standalone function constructor.
+     * @param func Standalone function
+    **/
+    FunctionRef(Standalone func) noexcept: function(func), invoker(specialized_invoker<Standalone, Return, Args...>) {}
+    /** Functor reference constructor, the functor must outlive the reference (a temporary functor lives until the end of the full expression).
+     * @param functor Functor to refer to
+    **/
+    template<class Type, class = enable_if_functor<Type>> FunctionRef(Type&& functor) noexcept: instance(const_cast<void*>(static_cast<void const*>(::std::addressof(functor)))) {
+        using Functor = typename ::std::remove_reference<Type>::type;
+        { // Check functor callability
+            using ResultOf = typename ::std::result_of<Functor&(Args...)>::type; // Since C++14, not defined if function can not be called with the arguments
+            static_assert(::std::is_same<Return, ResultOf>::value || ::std::is_base_of<Return, ResultOf>::value, "'Functor' result type is incompatible"); // '::std::is_same' needed for fundamental types
+        }
+        invoker = specialized_remote_invoker<Functor, Return, Args...>;
+    }
+    /** Function holder reference constructor, refers to the functor currently held (which must outlive the reference).
+     * @param func Function holder to refer to
+    **/
+    template<size_t other_storage_size, class OtherPolicy, size_t other_storage_align> FunctionRef(Function<Return(Args...), other_storage_size, OtherPolicy, other_storage_align> const& func) noexcept: instance(func.get_instance()) {
+        auto manager = func.get_manager();
+        invoker = manager ? manager->remote_invoker : empty_invoker<Return, Args...>; // Remote invoker, as given a pointer to the instance pointer
+    }
+public:
+    /** Tell whether a functor is referred, and so is callable.
+     * @return True if referred a functor, false otherwise
+    **/
+    operator bool() const noexcept {
+        return invoker != empty_invoker<Return, Args...>;
+    }
+    /** Call the referred function with the given parameters.
+     * @param ... Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    Return operator()(Args... args) const {
+        return invoker(const_cast<Standalone*>(&function), ::std::forward<Args>(args)...);
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Read indicator of atomic holders, i.e. per-epoch counters of the readers in progress, striped by thread.
+ * Readers arrive/depart in the current epoch without ever waiting; a writer waits for the readers of both epochs
+ * in turn (switching the current epoch in between), so readers that arrived before the writer started are all gone.
+**/
+class ReadIndicator final {
+private:
+    constexpr static size_t nb_stripes = 8; // Number of counter stripes, readers of different threads mostly update different cache lines
+    constexpr static size_t line_size = 64; // Assumed cache line size
+    /** Counters of one stripe, padded to a cache line.
+    **/
+    class Stripe final {
+    public:
+        ::std::atomic<size_t> counts[2]; // Readers in progress, per epoch
+        uint8_t padding[line_size > 2 * sizeof(::std::atomic<size_t>) ? line_size - 2 * sizeof(::std::atomic<size_t>) : 1];
+    };
+    Stripe stripes[nb_stripes]; // Reader counters
+    ::std::atomic<size_t> epoch; // Current epoch, 0 or 1
+private:
+    /** Get the stripe of the calling thread.
+     * @return Stripe index
+    **/
+    static size_t stripe() noexcept {
+        static ::std::atomic<size_t> next{0};
+        thread_local size_t index = next.fetch_add(1, ::std::memory_order_relaxed) % nb_stripes;
+        return index;
+    }
+    /** Wait until there is no reader in progress in a given epoch.
+     * @param epoch Epoch to wait for
+    **/
+    void drain(size_t epoch) const noexcept {
+        for (auto&& stripe: stripes) {
+            while (stripe.counts[epoch].load(::std::memory_order_seq_cst) != 0)
+                ::std::this_thread::yield();
+        }
+    }
+public:
+    /** Empty indicator constructor.
+    **/
+    ReadIndicator() noexcept: epoch(0) {
+        for (auto&& stripe: stripes) {
+            stripe.counts[0].store(0, ::std::memory_order_relaxed);
+            stripe.counts[1].store(0, ::std::memory_order_relaxed);
+        }
+    }
+    /** Register a reader in progress, wait-free.
+     * @return Counter to pass to 'depart'
+    **/
+    ::std::atomic<size_t>* arrive() noexcept {
+        auto count = &stripes[stripe()].counts[epoch.load(::std::memory_order_seq_cst)];
+        count->fetch_add(1, ::std::memory_order_seq_cst); // Ordered before the loads of the reader, so seen by any writer that published before these loads
+        return count;
+    }
+    /** Unregister a reader in progress, wait-free.
+     * @param count Counter returned by 'arrive'
+    **/
+    static void depart(::std::atomic<size_t>* count) noexcept {
+        count->fetch_sub(1, ::std::memory_order_release);
+    }
+    /** Wait until every reader registered before the call has departed (i.e. a grace period), writers must be serialized.
+    **/
+    void synchronize() noexcept {
+        auto current = epoch.load(::std::memory_order_relaxed);
+        drain(1 - current); // Late readers, that arrived in the previous epoch after the previous writer drained it
+        epoch.store(1 - current, ::std::memory_order_seq_cst);
+        drain(current);
+    }
+};
+
+/** Atomic function object holder template class, i.e. a function holder that can be called by many threads while being replaced.
+ * Calls are wait-free (besides the held function itself); replacing the held function is serialized between writers,
+ * and the replaced function is destroyed (through its manager) only once every call that could still use it has returned.
+ * @param Return(Args...)     Expected function type.
+ * @param local_storage_size  Size reserved for the local storage (in bytes, optional)
+ * @param Policy              Holder policy (optional)
+ * @param local_storage_align Alignment of the local storage (in bytes, optional)
+**/
+template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align> class AtomicFunction<Return(Args...), local_storage_size, Policy, local_storage_align> final {
+public:
+    /** Function holder class of the held functions.
+    **/
+    using Holder = Function<Return(Args...), local_storage_size, Policy, local_storage_align>;
+private:
+    /** Heap-stored function holder, replaced as a whole.
+    **/
+    class Node final {
+    public:
+        Holder function; // Held function
+    public:
+        template<class... CtorArgs> explicit Node(CtorArgs&&... args): function(::std::forward<CtorArgs>(args)...) {}
+    };
+    /** Reader in progress, for the lifetime of the instance.
+    **/
+    class Reading final {
+    private:
+        ::std::atomic<size_t>* count; // Counter to depart from
+    public:
+        Reading(ReadIndicator& readers) noexcept: count(readers.arrive()) {}
+        Reading(Reading const&) = delete;
+        ~Reading() {
+            ReadIndicator::depart(count);
         }
+    };
+private:
+    ::std::atomic<Node*> current; // Current held function (nullptr if none)
+    mutable ReadIndicator readers; // Calls in progress
+    ::std::mutex writer; // Serializes writers
+private:
+    /** Replace the current held function, then wait for the calls that could still use the previous one.
+     * @param node Held function to publish (nullptr for none)
+     * @return Previous held function (nullptr if none), to delete
+    **/
+    Node* publish(Node* node) {
+        ::std::lock_guard<::std::mutex> lock{writer};
+        auto previous = current.exchange(node, ::std::memory_order_seq_cst);
+        readers.synchronize();
+        return previous;
+    }
+    /** Make a node for a given held function.
+     * @param functor Function holder, standalone function or functor to copy/move (nullptr for none)
+     * @return Node to publish (nullptr for none)
+    **/
+    static Node* make(::std::nullptr_t) noexcept {
+        return nullptr;
+    }
+    template<class Functor> static Node* make(Functor&& functor) {
+        return new Node(::std::forward<Functor>(functor));
+    }
+public:
+    /** No function constructor.
+    **/
+    AtomicFunction() noexcept: current(nullptr) {}
+    AtomicFunction(::std::nullptr_t) noexcept: AtomicFunction() {}
+    /** Function holder/standalone function/functor constructor.
+     * @param functor Function holder, standalone function or functor to copy/move
+    **/
+    template<class Functor, class = typename ::std::enable_if<!::std::is_same<typename ::std::decay<Functor>::type, AtomicFunction>::value>::type> AtomicFunction(Functor&& functor): current(make(::std::forward<Functor>(functor))) {}
+    /** Deleted copy constructor/assignment, atomic holders are meant to be shared by reference.
+    **/
+    AtomicFunction(AtomicFunction const&) = delete;
+    AtomicFunction& operator=(AtomicFunction const&) = delete;
+    /** Destructor, there must not be any call in progress.
+    **/
+    ~AtomicFunction() {
+        delete current.load(::std::memory_order_relaxed);
+    }
+public:
+    /** Replace the held function, waiting for the calls in progress that could still use the previous one (so must not be called from the held function).
+     * @param functor Function holder, standalone function or functor to copy/move (nullptr for none)
+    **/
+    template<class Functor> void store(Functor&& functor) {
+        delete publish(make(::std::forward<Functor>(functor)));
+    }
+    /** Replace the held function, waiting for the calls in progress that could still use the previous one (so must not be called from the held function).
+     * @param functor Function holder, standalone function or functor to copy/move (nullptr for none)
+     * @return Previous held function
+    **/
+    template<class Functor> Holder exchange(Functor&& functor) {
+        ::std::unique_ptr<Node> previous{publish(make(::std::forward<Functor>(functor)))};
+        if (!previous)
+            return Holder{};
+        return Holder{::std::move(previous->function)};
+    }
+    /** Copy the held function.
+     * @return Copy of the held function
+    **/
+    Holder load() const {
+        Reading reading{readers};
+        auto node = current.load(::std::memory_order_seq_cst);
+        return node ? Holder{node->function} : Holder{};
+    }
+    /** Tell whether a function is held, and so is callable.
+     * @return True if held a function, false otherwise
+    **/
+    operator bool() const noexcept {
+        Reading reading{readers};
+        auto node = current.load(::std::memory_order_seq_cst);
+        return node && node->function;
+    }
+    /** Call the held function with the given parameters, wait-free; concurrent calls call the same functor concurrently.
+     * @param ... Arguments to pass to the function
+     * @return Return value of the function
+    **/
+    Return operator()(Args... args) {
+        Reading reading{readers};
+        auto node = current.load(::std::memory_order_seq_cst);
+        if (!node)
+            return empty_invoker<Return, Args...>(nullptr, ::std::forward<Args>(args)...);
+        return node->function.invoker(&node->function.storage, ::std::forward<Args>(args)...);
     }
 };
 
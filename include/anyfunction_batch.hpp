@@ -0,0 +1,199 @@
+/**
+ * @file   anyfunction_batch.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Batch invocation of function object holders, and batches of calls grouped by invoker.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include "anyfunction.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Batch invocation ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Batch invocation helpers, with access to the invoker and instance of function object holders.
+**/
+class Batch final {
+public:
+    /** Get the invoker and the instance (to pass to the invoker) of a holder.
+     * @param func Function object holder
+     * @return Invoker/instance
+    **/
+    template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align> static invoker_t<Return, Args...> invoker_of(Function<Return(Args...), local_storage_size, Policy, local_storage_align>& func) noexcept {
+        return func.invoker;
+    }
+    template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align> static void* instance_of(Function<Return(Args...), local_storage_size, Policy, local_storage_align>& func) noexcept {
+        return &func.storage;
+    }
+    /** Call a holder with arguments also passed to other calls.
+     * @param func Function object holder
+     * @param ...  Arguments, values not cheap to copy being copied (see 'broadcast_t')
+     * @return Return value of the function
+    **/
+    template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align, class... Params> static Return call(Function<Return(Args...), local_storage_size, Policy, local_storage_align>& func, Params&... params) {
+        return func.invoker(&func.storage, broadcast_t<Args>(params)...);
+    }
+    /** Call an invoker with the elements of a tuple.
+     * @param invoker  Invoker to call
+     * @param instance Instance to pass to the invoker
+     * @param tuple    Tuple of arguments, values not cheap to copy being copied (see 'broadcast_t')
+     * @return Return value of the function
+    **/
+    template<class Return, class... Args, class Tuple, size_t... indexes> static Return apply(invoker_t<Return, Args...> invoker, void* instance, Tuple& tuple, ::std::index_sequence<indexes...>) {
+        return invoker(instance, broadcast_t<Args>(::std::get<indexes>(tuple))...);
+    }
+    /** Call a holder once per tuple of arguments, with its invoker loaded once.
+     * @param func    Function object holder, not modified by its calls
+     * @param tuples  Range of argument tuples
+     * @param results Output iterator to assign the return values to (optional)
+    **/
+    template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align, class Tuples> static void each(Function<Return(Args...), local_storage_size, Policy, local_storage_align>& func, Tuples& tuples) {
+        auto invoker = func.invoker;
+        void* instance = &func.storage;
+        for (auto&& tuple: tuples)
+            apply<Return, Args...>(invoker, instance, tuple, ::std::index_sequence_for<Args...>{});
+    }
+    template<class Return, class... Args, size_t local_storage_size, class Policy, size_t local_storage_align, class Tuples, class Output> static Output each(Function<Return(Args...), local_storage_size, Policy, local_storage_align>& func, Tuples& tuples, Output results) {
+        auto invoker = func.invoker;
+        void* instance = &func.storage;
+        for (auto&& tuple: tuples) {
+            *results = apply<Return, Args...>(invoker, instance, tuple, ::std::index_sequence_for<Args...>{});
+            ++results;
+        }
+        return results;
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Batch of calls grouped by invoker, so that calls to functors of the same class run back to back.
+ * @param Return(Args...) Expected function type
+**/
+template<class Any> class BatchCalls;
+template<class Return, class... Args> class BatchCalls<Return(Args...)> final {
+private:
+    using Invoker = invoker_t<Return, Args...>;
+    ::std::vector<Invoker> invokers; // Invoker per group
+    ::std::vector<size_t> ends; // End position in 'instances' per group
+    ::std::vector<void*> instances; // Instance per call, grouped
+public:
+    /** Empty batch constructor.
+    **/
+    BatchCalls() = default;
+    /** Range constructor, see 'assign'.
+     * @param range Range of function object holders
+    **/
+    template<class Range> explicit BatchCalls(Range&& range) {
+        assign(range);
+    }
+public:
+    /** Group the calls to a range of holders, keeping their relative order within each group.
+     * @param range Range of function object holders, not moved nor modified while the batch is used
+    **/
+    template<class Range> void assign(Range&& range) {
+        ::std::vector<::std::pair<Invoker, void*>> calls;
+        for (auto&& func: range)
+            calls.emplace_back(Batch::invoker_of(func), Batch::instance_of(func));
+        ::std::stable_sort(calls.begin(), calls.end(), [](auto const& a, auto const& b) { return ::std::less<Invoker>{}(a.first, b.first); });
+        invokers.clear();
+        ends.clear();
+        instances.clear();
+        instances.reserve(calls.size());
+        for (auto&& call: calls) {
+            if (invokers.empty() || invokers.back() != call.first) {
+                if (!invokers.empty())
+                    ends.push_back(instances.size());
+                invokers.push_back(call.first);
+            }
+            instances.push_back(call.second);
+        }
+        if (!invokers.empty())
+            ends.push_back(instances.size());
+    }
+    /** Get the number of calls, or of groups (i.e. of distinct invokers).
+     * @return Number of calls/groups
+    **/
+    size_t size() const noexcept {
+        return instances.size();
+    }
+    size_t groups() const noexcept {
+        return invokers.size();
+    }
+    /** Make every call with the same arguments, group by group.
+     * @param ... Arguments, values not cheap to copy being copied for each call (see 'broadcast_t')
+    **/
+    template<class... Params> void operator()(Params&&... params) const {
+        size_t position = 0;
+        for (size_t group = 0; group < invokers.size(); ++group) {
+            auto invoker = invokers[group];
+            for (auto end = ends[group]; position < end; ++position)
+                invoker(instances[position], broadcast_t<Args>(params)...);
+        }
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Call every holder of a range with the same arguments, in range order (to group the calls by invoker, see 'BatchCalls').
+ * @param range Range of function object holders
+ * @param ...   Arguments, values not cheap to copy being copied for each call (see 'broadcast_t')
+**/
+template<class Range, class... Params> void invoke_all(Range&& range, Params&&... params) {
+    for (auto&& func: range)
+        Batch::call(func, params...);
+}
+
+/** Call a holder once per tuple of arguments, with its invoker loaded once.
+ * @param func    Function object holder, not modified by its calls
+ * @param tuples  Range of argument tuples (e.g. 'std::tuple' or 'std::pair'), values not cheap to copy being copied (see 'broadcast_t')
+ * @param results Output iterator to assign the return values to (optional)
+ * @return Output iterator past the last assigned return value
+**/
+template<class Holder, class Tuples> void invoke_each(Holder& func, Tuples&& tuples) {
+    Batch::each(func, tuples);
+}
+template<class Holder, class Tuples, class Output> Output invoke_each(Holder& func, Tuples&& tuples, Output results) {
+    return Batch::each(func, tuples, results);
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Batch invocation ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,416 @@
+/**
+ * @file   anyfunction_executor.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Work-stealing thread pool executor, with tasks stored inline in per-worker deques.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include "anyfunction.hpp"
+#include "anyfunction_queue.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Executor ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Work-stealing deque of function holders (Chase-Lev): the owner pushes/takes at the bottom, thieves steal at the top.
+ * Holders are moved in and out of the cells with their (never throwing) move constructor, so any locally-stored functor can be queued.
+ * A thief only moves a task out after claiming it, then releases its cell: the owner does not push into a cell not yet released.
+ * @param Task     Function holder class
+ * @param capacity Number of cells, a power of two
+**/
+template<class Task, size_t capacity> class StealingDeque final {
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "'capacity' must be a power of two");
+    static_assert(::std::is_nothrow_move_constructible<Task>::value, "Function holders must be moved without throwing");
+public:
+    /** Storage of a function holder, outside of the deque.
+    **/
+    using Storage = typename ::std::aligned_storage<sizeof(Task), alignof(Task)>::type;
+private:
+    /** Deque cell, holding a function holder.
+    **/
+    class Cell final {
+    public:
+        Storage storage; // Function holder, if occupied
+        ::std::atomic<bool> occupied; // Whether a function holder is in the cell, or still being moved out by a thief
+    };
+    ::std::atomic<int64_t> top; // Next position to steal
+    ::std::atomic<int64_t> bottom; // Next position to push
+    ::std::unique_ptr<Cell[]> cells; // Circular array of cells
+private:
+    /** Move a function holder out of a cell, then release the cell.
+     * @param cell    Occupied cell
+     * @param storage Storage to move the holder into
+    **/
+    static void move_out(Cell& cell, Storage& storage) noexcept {
+        auto task = reinterpret_cast<Task*>(&cell.storage);
+        new(&storage) Task{::std::move(*task)};
+        task->~Task();
+        cell.occupied.store(false, ::std::memory_order_release);
+    }
+public:
+    /** Empty deque constructor.
+    **/
+    StealingDeque(): top(0), bottom(0), cells(new Cell[capacity]) {
+        for (size_t i = 0; i < capacity; ++i)
+            cells[i].occupied.store(false, ::std::memory_order_relaxed);
+    }
+    StealingDeque(StealingDeque const&) = delete;
+    /** Destroy the remaining function holders.
+    **/
+    ~StealingDeque() {
+        Storage storage;
+        while (take(storage))
+            reinterpret_cast<Task*>(&storage)->~Task();
+    }
+public:
+    /** Tell whether the deque is (approximately) empty.
+     * @return True if empty, false otherwise
+    **/
+    bool empty() const noexcept {
+        return bottom.load(::std::memory_order_relaxed) <= top.load(::std::memory_order_relaxed);
+    }
+    /** Push a function holder at the bottom, owner only.
+     * @param storage Function holder to move (destroyed, so left as raw memory, if pushed)
+     * @return Whether the holder was pushed (false if full)
+    **/
+    bool push(Storage& storage) noexcept {
+        auto b = bottom.load(::std::memory_order_relaxed);
+        auto t = top.load(::std::memory_order_acquire);
+        if (b - t >= static_cast<int64_t>(capacity)) // Full
+            return false;
+        auto& cell = cells[static_cast<size_t>(b) & (capacity - 1)];
+        if (cell.occupied.load(::std::memory_order_acquire)) // Stolen task still being moved out, so full
+            return false;
+        auto task = reinterpret_cast<Task*>(&storage);
+        new(&cell.storage) Task{::std::move(*task)};
+        task->~Task();
+        cell.occupied.store(true, ::std::memory_order_relaxed);
+        bottom.store(b + 1, ::std::memory_order_release);
+        return true;
+    }
+    /** Take the function holder at the bottom, owner only.
+     * @param storage Storage to move the holder into
+     * @return Whether a holder was taken (false if empty)
+    **/
+    bool take(Storage& storage) noexcept {
+        auto b = bottom.load(::std::memory_order_relaxed) - 1;
+        bottom.store(b, ::std::memory_order_seq_cst);
+        auto t = top.load(::std::memory_order_seq_cst);
+        if (t > b) { // Empty
+            bottom.store(b + 1, ::std::memory_order_relaxed);
+            return false;
+        }
+        auto& cell = cells[static_cast<size_t>(b) & (capacity - 1)];
+        if (t < b) { // Not the last one, no thief can reach it
+            move_out(cell, storage);
+            return true;
+        }
+        auto taken = top.compare_exchange_strong(t, t + 1, ::std::memory_order_seq_cst, ::std::memory_order_relaxed); // Race with thieves for the last one
+        bottom.store(b + 1, ::std::memory_order_relaxed);
+        if (taken)
+            move_out(cell, storage);
+        return taken;
+    }
+    /** Steal the function holder at the top, any thread.
+     * @param storage Storage to move the holder into
+     * @return Whether a holder was stolen (false if empty or lost a race)
+    **/
+    bool steal(Storage& storage) noexcept {
+        auto t = top.load(::std::memory_order_seq_cst);
+        auto b = bottom.load(::std::memory_order_seq_cst);
+        if (t >= b) // Empty
+            return false;
+        if (!top.compare_exchange_strong(t, t + 1, ::std::memory_order_seq_cst, ::std::memory_order_relaxed))
+            return false;
+        move_out(cells[static_cast<size_t>(t) & (capacity - 1)], storage); // Claimed, the owner does not reuse the cell until released
+        return true;
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Work-stealing thread pool executor.
+ * Each worker owns a deque of tasks (function holders stored inline), pushes the tasks it posts and runs them last-in first-out,
+ * and steals the oldest tasks of a random worker when it has none; tasks posted from other threads go through a shared queue.
+ * Idle workers park on a condition variable, and are woken up by new tasks.
+ * @param local_storage_size Size reserved for the local storage of each task (in bytes, optional)
+ * @param deque_capacity     Number of tasks per worker deque, a power of two (optional)
+**/
+template<size_t local_storage_size = 32, size_t deque_capacity = 1024> class Executor final {
+public:
+    /** Task holder class.
+    **/
+    using Task = UniqueFunction<void(), local_storage_size>;
+private:
+    using Deque = StealingDeque<Task, deque_capacity>;
+    using Storage = typename Deque::Storage;
+    /** Worker state.
+    **/
+    class Worker final {
+    public:
+        Deque deque; // Own tasks
+        ::std::thread thread; // Worker thread
+        uint64_t seed; // Random victim generator state
+    };
+private:
+    ::std::vector<::std::unique_ptr<Worker>> workers; // Worker states
+    MpmcFunctionQueue<void(), local_storage_size> injection; // Tasks posted from other threads
+    ::std::atomic<size_t> pending; // Posted tasks not yet completed
+    ::std::atomic<bool> stopping; // Whether the workers must stop
+    ::std::atomic<size_t> sleepers; // Parked workers
+    ::std::atomic<uint64_t> signals; // Number of wake-up signals
+    ::std::mutex park_lock; // Parking lock
+    ::std::condition_variable park_cond; // Parking condition
+    ::std::mutex idle_lock; // Idle waiting lock
+    ::std::condition_variable idle_cond; // Idle waiting condition
+private:
+    /** Worker of the calling thread, with its executor.
+    **/
+    class Current final {
+    public:
+        Executor const* executor; // Executor of the worker (nullptr if not a worker thread)
+        Worker* worker; // Worker state
+    };
+    /** Get the worker of the calling thread.
+     * @return Worker of the calling thread (nullptr if not a worker of this executor)
+    **/
+    static Current& current_worker() noexcept {
+        thread_local Current current{nullptr, nullptr};
+        return current;
+    }
+    Worker* get_worker() const noexcept {
+        auto& current = current_worker();
+        return current.executor == this ? current.worker : nullptr;
+    }
+    /** Construct a task in a storage: function holders of the same signature are copied/moved into it (never wrapped in another holder), other functors constructed in place.
+     * @param storage Storage to construct the task in
+     * @param functor Function holder, standalone function or functor to copy/move
+     * @return Constructed task
+    **/
+    template<class Functor> static Task* make_task(Storage& storage, Functor&& functor, ::std::true_type) {
+        return new(&storage) Task{::std::forward<Functor>(functor)}; // Can throw
+    }
+    template<class Functor> static Task* make_task(Storage& storage, Functor&& functor, ::std::false_type) {
+        return new(&storage) Task{in_place_type<typename ::std::decay<Functor>::type>, ::std::forward<Functor>(functor)}; // Can throw
+    }
+    /** Run a task moved out of a deque, then destroy it.
+     * @param storage Task moved out of a deque
+    **/
+    void run(Storage& storage) {
+        auto task = reinterpret_cast<Task*>(&storage);
+        (*task)();
+        task->~Task();
+        complete();
+    }
+    void run(Task& task) {
+        task();
+        task.clear();
+        complete();
+    }
+    /** Account for a completed task, waking up the idle waiters if it was the last one.
+    **/
+    void complete() {
+        if (pending.fetch_sub(1, ::std::memory_order_acq_rel) == 1) {
+            ::std::lock_guard<::std::mutex> lock{idle_lock};
+            idle_cond.notify_all();
+        }
+    }
+    /** Wake up one parked worker, if any.
+    **/
+    void notify() {
+        signals.fetch_add(1, ::std::memory_order_seq_cst);
+        if (sleepers.load(::std::memory_order_seq_cst) == 0)
+            return;
+        ::std::lock_guard<::std::mutex> lock{park_lock};
+        park_cond.notify_one();
+    }
+    /** Tell whether there is (approximately) any task to run.
+     * @return True if there is a task, false otherwise
+    **/
+    bool has_tasks() const noexcept {
+        if (injection.size() != 0)
+            return true;
+        for (auto&& worker: workers) {
+            if (!worker->deque.empty())
+                return true;
+        }
+        return false;
+    }
+    /** Find and run one task: own task, shared queue task, or task stolen from a random worker.
+     * @param worker Worker looking for a task
+     * @return Whether a task was run
+    **/
+    bool run_one(Worker& worker) {
+        Storage storage;
+        if (worker.deque.take(storage)) {
+            run(storage);
+            return true;
+        }
+        Task task;
+        if (injection.try_pop(task)) {
+            run(task);
+            return true;
+        }
+        auto count = workers.size();
+        worker.seed ^= worker.seed << 13; // Xorshift
+        worker.seed ^= worker.seed >> 7;
+        worker.seed ^= worker.seed << 17;
+        auto first = static_cast<size_t>(worker.seed % count);
+        for (size_t i = 0; i < count; ++i) {
+            auto& victim = *workers[(first + i) % count];
+            if (&victim != &worker && victim.deque.steal(storage)) {
+                run(storage);
+                return true;
+            }
+        }
+        return false;
+    }
+    /** Park until a wake-up signal or the executor stops.
+    **/
+    void park() {
+        auto seen = signals.load(::std::memory_order_seq_cst);
+        sleepers.fetch_add(1, ::std::memory_order_seq_cst);
+        if (!has_tasks() && !stopping.load(::std::memory_order_seq_cst)) { // Tasks posted before this check are seen, later ones signal
+            ::std::unique_lock<::std::mutex> lock{park_lock};
+            park_cond.wait(lock, [&]() { return signals.load(::std::memory_order_seq_cst) != seen || stopping.load(::std::memory_order_seq_cst); });
+        }
+        sleepers.fetch_sub(1, ::std::memory_order_seq_cst);
+    }
+    /** Worker thread loop.
+     * @param worker Worker state
+    **/
+    void work(Worker& worker) {
+        current_worker() = Current{this, &worker};
+        while (!stopping.load(::std::memory_order_relaxed)) {
+            if (!run_one(worker))
+                park();
+        }
+        current_worker() = Current{nullptr, nullptr};
+    }
+public:
+    /** Start the worker threads.
+     * @param nb_workers    Number of worker threads (0 for the number of hardware threads)
+     * @param queue_capacity Number of slots of the queue of the tasks posted from other threads (optional)
+    **/
+    explicit Executor(size_t nb_workers = 0, size_t queue_capacity = 4096): injection(queue_capacity), pending(0), stopping(false), sleepers(0), signals(0) {
+        if (nb_workers == 0)
+            nb_workers = ::std::thread::hardware_concurrency();
+        if (nb_workers == 0)
+            nb_workers = 1;
+        for (size_t i = 0; i < nb_workers; ++i) {
+            workers.emplace_back(new Worker{});
+            workers.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
+        for (auto&& worker: workers) {
+            auto state = worker.get();
+            worker->thread = ::std::thread{[this, state]() { work(*state); }};
+        }
+    }
+    Executor(Executor const&) = delete;
+    Executor& operator=(Executor const&) = delete;
+    /** Wait for all the posted tasks to complete, then stop the worker threads.
+    **/
+    ~Executor() {
+        wait_idle();
+        stopping.store(true, ::std::memory_order_seq_cst);
+        {
+            ::std::lock_guard<::std::mutex> lock{park_lock};
+            park_cond.notify_all();
+        }
+        for (auto&& worker: workers)
+            worker->thread.join();
+    }
+public:
+    /** Get the number of worker threads.
+     * @return Number of worker threads
+    **/
+    size_t size() const noexcept {
+        return workers.size();
+    }
+    /** Post a task, to run once on any worker; tasks posted from a worker are pushed to its own deque (without allocation if the functor fits).
+     * @param functor Function holder, standalone function or functor to copy/move, must not throw when called
+    **/
+    template<class Functor> void post(Functor&& functor) {
+        Storage storage;
+        auto task = make_task(storage, ::std::forward<Functor>(functor), ::std::integral_constant<bool, is_function_holder<typename ::std::decay<Functor>::type>::value && ::std::is_constructible<Task, Functor&&>::value>{}); // Can throw
+        pending.fetch_add(1, ::std::memory_order_relaxed);
+        auto worker = get_worker();
+        if (worker && worker->deque.push(storage)) { // Moved into the deque
+            notify();
+            return;
+        }
+        while (!injection.try_push(::std::move(*task))) { // Full shared queue
+            if (worker) { // Run it now, rather than waiting for the other workers
+                run(*task);
+                task->~Task();
+                return;
+            }
+            ::std::this_thread::yield();
+        }
+        task->~Task();
+        notify();
+    }
+    /** Submit a task, to run once on any worker.
+     * @param functor Functor to copy/move
+     * @return Future of the task result
+    **/
+    template<class Functor> auto submit(Functor&& functor) -> ::std::future<decltype(functor())> {
+        ::std::packaged_task<decltype(functor())()> task{::std::forward<Functor>(functor)};
+        auto future = task.get_future();
+        post(::std::move(task));
+        return future;
+    }
+    /** Wait until every posted task has completed, including the tasks they posted; must not be called from a task.
+    **/
+    void wait_idle() {
+        ::std::unique_lock<::std::mutex> lock{idle_lock};
+        idle_cond.wait(lock, [&]() { return pending.load(::std::memory_order_acquire) == 0; });
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Executor ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
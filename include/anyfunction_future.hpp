@@ -0,0 +1,674 @@
+/**
+ * @file   anyfunction_future.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Futures and promises, with continuations stored inline in one shared state.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Internal headers
+#include "anyfunction.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Futures ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+template<class Value> class Future;
+template<class Value> class Promise;
+template<class Result, class... Values> class Join;
+
+/** Value class stored for 'void' futures.
+**/
+struct Unit {};
+
+/** Stored value class of a future.
+ * @param Value Future value class
+**/
+template<class Value> using stored_t = typename ::std::conditional<::std::is_void<Value>::value, Unit, Value>::type;
+
+/** Shared state of a promise and its future: the value and the pending continuations, in one allocation.
+ * Continuations transform the value in place (so its class changes along a chain), a chain only moves to a new state when the continuations do not fit.
+**/
+class FutureState final {
+public:
+    constexpr static size_t storage_size = 48; // Size of the value storage, larger values are heap-stored
+    constexpr static size_t nb_steps = 6; // Number of pending continuations stored inline (the last one being reserved to move to a new state)
+    /** Continuation class, called with the state once it holds a value or an error.
+    **/
+    using Step = UniqueFunction<void(FutureState&), 32>;
+private:
+    /** State status.
+    **/
+    enum class Status {
+        pending, // No value yet
+        value, // Holds a value
+        error // Holds an error
+    };
+private:
+    ::std::atomic<size_t> refs; // Number of promises/futures referring to the state
+    ::std::mutex lock; // Lock of the status and of the continuations
+    ::std::condition_variable settled; // Condition of the settled state, i.e. holding a value or an error, with no continuation left
+    Status status; // Current status
+    bool running; // Whether a thread is running the continuations
+    size_t first; // Position of the first pending continuation
+    size_t count; // Number of pending continuations
+    Step steps[nb_steps]; // Ring of pending continuations
+    alignas(::std::max_align_t) unsigned char storage[storage_size]; // Value storage (or pointer to the heap-stored value)
+    void (*destroy)(void*); // Destroy the held value (nullptr if none)
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+    ::std::exception_ptr error; // Held error (nullptr for a broken promise)
+#endif
+private:
+    /** Tell whether a value class is stored in the value storage.
+     * @param Value Value class
+     * @return True if stored in the state, false if heap-stored
+    **/
+    template<class Value> constexpr static bool fits() noexcept {
+        return sizeof(Value) <= storage_size && alignof(Value) <= alignof(::std::max_align_t);
+    }
+    /** Run the pending continuations, until none is left.
+     * The continuations of this header hold their errors instead of throwing; should one throw anyway, the remaining ones still run, the state is settled, then the first error is raised.
+     * @param guard Lock guard, locked
+    **/
+    void drain(::std::unique_lock<::std::mutex>& guard) {
+        running = true;
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+        ::std::exception_ptr thrown; // First error thrown by a continuation
+#endif
+        while (count > 0) {
+            Step step{::std::move(steps[first])};
+            first = (first + 1) % nb_steps;
+            --count;
+            guard.unlock();
+            ANYFUNCTION_TRY {
+                step(*this);
+            } ANYFUNCTION_CATCH_ALL {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+                if (!thrown)
+                    thrown = ::std::current_exception();
+#endif
+            }
+            step.clear();
+            guard.lock();
+        }
+        running = false;
+        settled.notify_all();
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+        if (thrown) {
+            guard.unlock();
+            ::std::rethrow_exception(thrown);
+        }
+#endif
+    }
+public:
+    /** Pending state constructor, referred to by one promise/future.
+    **/
+    FutureState() noexcept: refs(1), status(Status::pending), running(false), first(0), count(0), destroy(nullptr) {}
+    FutureState(FutureState const&) = delete;
+    ~FutureState() {
+        reset();
+    }
+public:
+    /** Refer to the state from one more/less promise/future, deleting it after the last one.
+    **/
+    void acquire() noexcept {
+        refs.fetch_add(1, ::std::memory_order_relaxed);
+    }
+    void release() noexcept {
+        if (refs.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+    /** Construct/get/take/destroy the held value, only from the thread settling the state or from its continuations.
+     * @param Value Value class
+     * @param ...   Value constructor arguments
+     * @return Value
+    **/
+    template<class Value, class... CtorArgs> void emplace(CtorArgs&&... args) {
+        if (fits<Value>()) {
+            new(storage) Value(::std::forward<CtorArgs>(args)...); // Can throw
+            destroy = [](void* instance) { reinterpret_cast<Value*>(instance)->~Value(); };
+        } else {
+            *reinterpret_cast<Value**>(storage) = new Value(::std::forward<CtorArgs>(args)...); // Can throw
+            destroy = [](void* instance) { delete *reinterpret_cast<Value**>(instance); };
+        }
+    }
+    template<class Value> Value& get() noexcept {
+        return fits<Value>() ? *reinterpret_cast<Value*>(storage) : **reinterpret_cast<Value**>(storage);
+    }
+    template<class Value> Value take() {
+        Value value{::std::move(get<Value>())};
+        reset();
+        return value;
+    }
+    void reset() noexcept {
+        if (destroy) {
+            destroy(storage);
+            destroy = nullptr;
+        }
+    }
+    /** Tell whether the state holds a value (false for an error), only from the thread settling the state or from its continuations.
+     * @return Whether holding a value
+    **/
+    bool has_value() const noexcept {
+        return status == Status::value;
+    }
+    /** Replace the held value by an error, only from a continuation.
+     * @param error Error to hold (nullptr for a broken promise)
+    **/
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+    void fail(::std::exception_ptr error) {
+        reset();
+        this->error = ::std::move(error);
+        ::std::lock_guard<::std::mutex> guard{lock};
+        status = Status::error;
+    }
+#else
+    void fail() {
+        reset();
+        ::std::lock_guard<::std::mutex> guard{lock};
+        status = Status::error;
+    }
+#endif
+    /** Raise the held error, only once settled.
+    **/
+    [[noreturn]] void raise() const {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+        if (error)
+            ::std::rethrow_exception(error);
+#endif
+        Exception::raise<Exception::BrokenPromise>();
+    }
+    /** Settle a pending state with the value constructed by 'emplace' (called before), then run the continuations.
+    **/
+    void settle_value() {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        status = Status::value;
+        drain(guard);
+    }
+    /** Settle a pending state with an error, then run the continuations.
+     * @param error Error to hold (nullptr for a broken promise)
+    **/
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+    void settle_error(::std::exception_ptr error) {
+        this->error = ::std::move(error);
+        ::std::unique_lock<::std::mutex> guard{lock};
+        status = Status::error;
+        drain(guard);
+    }
+#else
+    void settle_error() {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        status = Status::error;
+        drain(guard);
+    }
+#endif
+    /** Append a continuation, run at once if the state is settled.
+     * @param step Continuation to append
+     * @param last Whether the continuation slot reserved to move to a new state can be used
+     * @return Whether the continuation was appended (false if no slot left)
+    **/
+    bool push(Step& step, bool last) {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        if (count + (last ? 0 : 1) >= nb_steps)
+            return false;
+        steps[(first + count) % nb_steps] = ::std::move(step);
+        ++count;
+        if (status != Status::pending && !running)
+            drain(guard);
+        return true;
+    }
+    /** Check whether the state is settled, or wait for it.
+     * @return Whether settled
+    **/
+    bool is_ready() {
+        ::std::lock_guard<::std::mutex> guard{lock};
+        return !running && count == 0 && status != Status::pending;
+    }
+    void wait() {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        settled.wait(guard, [&]() { return !running && count == 0 && status != Status::pending; });
+    }
+    /** Move the held value or error to another pending state, settling it, only from a continuation.
+     * @param Value  Held value class
+     * @param target State to settle
+    **/
+    template<class Value> void forward(FutureState& target) {
+        if (has_value()) {
+            ANYFUNCTION_TRY {
+                target.emplace<Value>(take<Value>());
+            } ANYFUNCTION_CATCH_ALL { // Settle the target with the error, so its future does not wait forever
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+                target.settle_error(::std::current_exception());
+#else
+                target.settle_error();
+#endif
+                return;
+            }
+            target.settle_value();
+        } else {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+            target.settle_error(error);
+#else
+            target.settle_error();
+#endif
+        }
+    }
+};
+
+/** Call a continuation with a future value, and the class of its result.
+ * @param functor Continuation to call
+ * @param value   Future value to pass (none for 'void' futures)
+ * @return Continuation result
+**/
+template<class Functor> auto call_with(Functor& functor, Unit&&) -> decltype(functor()) {
+    return functor();
+}
+template<class Functor, class Value> auto call_with(Functor& functor, Value&& value) -> decltype(functor(::std::move(value))) {
+    return functor(::std::move(value));
+}
+template<class Functor, class Value> using continuation_result_t = decltype(call_with(::std::declval<Functor&>(), ::std::declval<stored_t<Value>&&>()));
+
+/** Replace the held value of a state by the result of a continuation called with it.
+ * @param Value   Held value class
+ * @param Result  Continuation result class
+ * @param state   State holding the value
+ * @param functor Continuation to call
+**/
+template<class Value, class Result, class Functor> void transform(FutureState& state, Functor& functor, ::std::true_type) {
+    call_with(functor, state.take<stored_t<Value>>());
+    state.emplace<Unit>();
+}
+template<class Value, class Result, class Functor> void transform(FutureState& state, Functor& functor, ::std::false_type) {
+    auto&& result = call_with(functor, state.take<stored_t<Value>>());
+    state.emplace<Result>(::std::forward<decltype(result)>(result));
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Future value, consumed once: by 'get', or by chaining a continuation with 'then'.
+ * @param Value Value class ('void' for none)
+**/
+template<class Value> class Future final {
+    template<class> friend class Future;
+    template<class> friend class Promise;
+    template<class, class...> friend class Join;
+private:
+    FutureState* state; // Shared state (nullptr if none)
+private:
+    /** Shared state constructor, taking over one reference.
+     * @param state Shared state
+    **/
+    explicit Future(FutureState* state) noexcept: state(state) {}
+    /** Check the future has a shared state.
+    **/
+    void check() const {
+        if (!state)
+            Exception::raise<Exception::NoState>();
+    }
+    /** Take the value of a settled future, or its stored value ('Unit' for 'void' futures), consuming it.
+     * @return Value, the held error being raised instead if any
+    **/
+    stored_t<Value> take_stored() {
+        Future future{::std::move(*this)};
+        if (!future.state->has_value())
+            future.state->raise();
+        return future.state->template take<stored_t<Value>>();
+    }
+    Value take() {
+        return static_cast<Value>(take_stored());
+    }
+    /** Append a continuation, moving the chain to a new state if the continuations of the current one are full.
+     * @param Result Value class once the continuation has run
+     * @param step   Continuation to append
+     * @return Future of the value once the continuation has run
+    **/
+    template<class Result> Future<Result> attach(FutureState::Step& step) {
+        check();
+        auto current = state;
+        if (!current->push(step, false)) { // Move the chain to a new state
+            auto next = new FutureState{}; // Can throw
+            next->acquire(); // Referred to by the moving continuation
+            FutureState::Step move = [next](FutureState& state) {
+                state.template forward<stored_t<Value>>(*next);
+                next->release();
+            };
+            current->push(move, true); // Reserved slot, so never full
+            current->release();
+            current = next;
+            current->push(step, false);
+        }
+        state = nullptr;
+        return Future<Result>{current};
+    }
+public:
+    /** No shared state constructor.
+    **/
+    Future() noexcept: state(nullptr) {}
+    /** Move constructor/assignment.
+     * @param other Future to move
+     * @return Current instance
+    **/
+    Future(Future&& other) noexcept: state(other.state) {
+        other.state = nullptr;
+    }
+    Future& operator=(Future&& other) noexcept {
+        Future{::std::move(other)}.swap(*this);
+        return *this;
+    }
+    Future(Future const&) = delete;
+    ~Future() {
+        if (state)
+            state->release();
+    }
+public:
+    /** Swap with another future.
+     * @param other Future to swap with
+    **/
+    void swap(Future& other) noexcept {
+        ::std::swap(state, other.state);
+    }
+    /** Tell whether the future has a shared state, i.e. has not been consumed.
+     * @return Whether the future is valid
+    **/
+    bool valid() const noexcept {
+        return state != nullptr;
+    }
+    /** Tell whether the value (or error) is available, or wait for it.
+     * @return Whether available
+    **/
+    bool is_ready() const {
+        check();
+        return state->is_ready();
+    }
+    void wait() const {
+        check();
+        state->wait();
+    }
+    /** Wait for the value, then take it, consuming the future.
+     * @return Value, the held error being raised instead if any
+    **/
+    Value get() {
+        wait();
+        return take();
+    }
+    /** Chain a continuation, called with the value once available (not called on error, which is forwarded), consuming the future.
+     * @param functor Continuation to copy/move, taking the value (nothing for 'void' futures)
+     * @return Future of the continuation result, or of its error if it throws
+    **/
+    template<class Functor> auto then(Functor&& functor) -> Future<continuation_result_t<typename ::std::decay<Functor>::type, Value>> {
+        using Decayed = typename ::std::decay<Functor>::type;
+        using Result = continuation_result_t<Decayed, Value>;
+        FutureState::Step step = [functor = Decayed{::std::forward<Functor>(functor)}](FutureState& state) mutable {
+            if (!state.has_value()) // Error forwarded
+                return;
+            ANYFUNCTION_TRY {
+                transform<Value, stored_t<Result>>(state, functor, ::std::is_void<Result>{});
+            } ANYFUNCTION_CATCH_ALL {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+                state.fail(::std::current_exception());
+#endif
+            }
+        };
+        return attach<Result>(step);
+    }
+};
+
+/** Promise of a future value, settled once with a value or an error; a promise destroyed before being settled breaks its future.
+ * @param Value Value class ('void' for none)
+**/
+template<class Value> class Promise final {
+private:
+    FutureState* state; // Shared state (nullptr if none)
+    bool retrieved; // Whether the future was retrieved
+    bool satisfied; // Whether the state was settled
+private:
+    /** Check the promise has a shared state and was not settled.
+    **/
+    void check() const {
+        if (!state || satisfied)
+            Exception::raise<Exception::NoState>();
+    }
+public:
+    /** Shared state constructor, allocating the only block of the future (and of its chained continuations, if they fit).
+    **/
+    Promise(): state(new FutureState{}), retrieved(false), satisfied(false) {}
+    /** Move constructor/assignment.
+     * @param other Promise to move
+     * @return Current instance
+    **/
+    Promise(Promise&& other) noexcept: state(other.state), retrieved(other.retrieved), satisfied(other.satisfied) {
+        other.state = nullptr;
+    }
+    Promise& operator=(Promise&& other) noexcept {
+        Promise{::std::move(other)}.swap(*this);
+        return *this;
+    }
+    Promise(Promise const&) = delete;
+    /** Break the future if not settled.
+    **/
+    ~Promise() {
+        if (!state)
+            return;
+        if (!satisfied) {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+            state->settle_error(nullptr);
+#else
+            state->settle_error();
+#endif
+        }
+        state->release();
+    }
+public:
+    /** Swap with another promise.
+     * @param other Promise to swap with
+    **/
+    void swap(Promise& other) noexcept {
+        ::std::swap(state, other.state);
+        ::std::swap(retrieved, other.retrieved);
+        ::std::swap(satisfied, other.satisfied);
+    }
+    /** Get the future, only once.
+     * @return Future of the promised value
+    **/
+    Future<Value> get_future() {
+        if (!state || retrieved)
+            Exception::raise<Exception::NoState>();
+        retrieved = true;
+        state->acquire();
+        return Future<Value>{state};
+    }
+    /** Settle with a value, constructed in place, running the chained continuations in the calling thread.
+     * @param ... Value constructor arguments
+    **/
+    template<class... CtorArgs> void set_value(CtorArgs&&... args) {
+        check();
+        state->template emplace<stored_t<Value>>(::std::forward<CtorArgs>(args)...); // Can throw
+        satisfied = true;
+        state->settle_value();
+    }
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+    /** Settle with an error, running the chained continuations in the calling thread.
+     * @param error Error to hold
+    **/
+    void set_exception(::std::exception_ptr error) {
+        check();
+        satisfied = true;
+        state->settle_error(::std::move(error));
+    }
+#endif
+};
+
+/** Make a future holding a value.
+ * @param value Value to copy/move
+ * @return Ready future
+**/
+template<class Value> Future<typename ::std::decay<Value>::type> make_ready_future(Value&& value) {
+    Promise<typename ::std::decay<Value>::type> promise;
+    auto future = promise.get_future();
+    promise.set_value(::std::forward<Value>(value));
+    return future;
+}
+inline Future<void> make_ready_future() {
+    Promise<void> promise;
+    auto future = promise.get_future();
+    promise.set_value();
+    return future;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Join of several futures: holds them, and is notified as each one settles.
+ * @param Result    Value class of the joined future
+ * @param Values... Value classes of the held futures
+**/
+template<class Result, class... Values> class Join final {
+public:
+    ::std::tuple<Future<Values>...> futures; // Held futures
+    Promise<Result> promise; // Promise of the joined value
+    ::std::atomic<size_t> left; // Number of notifications left, including the one of the creator
+    ::std::atomic<bool> done; // Whether the joined value was settled (for 'when_any')
+public:
+    Join(): left(sizeof...(Values) + 1), done(false) {}
+    /** Attach a notification continuation to a future, then hold it.
+     * @param index    Index of the future
+     * @param future   Future to hold
+     * @param notified Continuation, called with the join, the index and the settled state
+    **/
+    template<size_t index, class Value, class Notified> void hold(Future<Value>& future, Notified notified) {
+        FutureState::Step step = [this, notified](FutureState& state) {
+            notified(*this, index, state);
+        };
+        ::std::get<index>(futures) = future.template attach<Value>(step);
+    }
+    /** Take the values of the held futures, all settled, or the first error.
+     * @return Values
+    **/
+    template<size_t... indexes> ::std::tuple<stored_t<Values>...> take_all(::std::index_sequence<indexes...>) {
+        return ::std::tuple<stored_t<Values>...>{::std::get<indexes>(futures).take_stored()...};
+    }
+    /** Count one notification.
+     * @return Whether it was the last one (the join must then be deleted)
+    **/
+    bool arrive() noexcept {
+        return left.fetch_sub(1, ::std::memory_order_acq_rel) == 1;
+    }
+};
+
+/** Attach the notification continuations of a join.
+ * @param join     Join to hold the futures
+ * @param notified Notification continuation
+ * @param ...      Futures to hold
+**/
+template<class Join, class Notified, class... Values, size_t... indexes> void hold_all(Join& join, Notified notified, ::std::index_sequence<indexes...>, Future<Values>&... futures) {
+    int expand[] = {0, (join.template hold<indexes>(futures, notified), 0)...};
+    (void) expand;
+}
+
+/** Join futures into a future of all their values, or of the first error.
+ * @param ... Futures to join, consumed
+ * @return Future of all the values ('Unit' for 'void' futures)
+**/
+template<class... Values> Future<::std::tuple<stored_t<Values>...>> when_all(Future<Values>&&... futures) {
+    static_assert(sizeof...(Values) > 0, "At least one future to join");
+    using Result = ::std::tuple<stored_t<Values>...>;
+    using Joined = Join<Result, Values...>;
+    auto join = new Joined{}; // Can throw
+    auto future = join->promise.get_future();
+    auto complete = [](Joined& join) { // Last notification, all the futures are settled
+        ANYFUNCTION_TRY {
+            join.promise.set_value(join.take_all(::std::index_sequence_for<Values...>{}));
+        } ANYFUNCTION_CATCH_ALL {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+            join.promise.set_exception(::std::current_exception());
+#endif
+        }
+        delete &join;
+    };
+    hold_all(*join, [complete](Joined& join, size_t, FutureState&) {
+        if (join.arrive())
+            complete(join);
+    }, ::std::index_sequence_for<Values...>{}, futures...);
+    if (join->arrive())
+        complete(*join);
+    return future;
+}
+
+/** Join futures of the same value class into a future of the first value or error.
+ * @param ... Futures to join, consumed
+ * @return Future of the index of the first settled future, and of its value ('Unit' for 'void' futures)
+**/
+template<class Value, class... Values> Future<::std::pair<size_t, stored_t<Value>>> when_any(Future<Value>&& first, Future<Values>&&... others) {
+    static_assert(::std::is_same<::std::tuple<Value, Values...>, ::std::tuple<Values..., Value>>::value, "Futures of the same value class expected"); // Equal to its rotation only if all the same
+    using Result = ::std::pair<size_t, stored_t<Value>>;
+    using Joined = Join<Result, Value, Values...>;
+    auto join = new Joined{}; // Can throw
+    auto future = join->promise.get_future();
+    hold_all(*join, [](Joined& join, size_t index, FutureState& state) {
+        if (!join.done.exchange(true, ::std::memory_order_acq_rel)) { // First settled
+            if (state.has_value()) {
+                ANYFUNCTION_TRY {
+                    join.promise.set_value(index, ::std::move(state.template get<stored_t<Value>>()));
+                } ANYFUNCTION_CATCH_ALL { // Value not constructed, the promise is not settled yet
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+                    join.promise.set_exception(::std::current_exception());
+#endif
+                }
+            } else {
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+                ANYFUNCTION_TRY {
+                    state.raise();
+                } ANYFUNCTION_CATCH_ALL {
+                    join.promise.set_exception(::std::current_exception());
+                }
+#endif
+            }
+        }
+        if (join.arrive())
+            delete &join;
+    }, ::std::index_sequence_for<Value, Values...>{}, first, others...);
+    if (join->arrive())
+        delete join;
+    return future;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Futures ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,245 @@
+/**
+ * @file   anyfunction_queue.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Bounded, lock-free queues of function object holders, with closures stored in the ring slots.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Internal headers
+#include "anyfunction.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Function queues ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function queue template class declaration.
+**/
+template<class Any, size_t local_storage_size = 32, bool multi_consumer = true, class Policy = UniquePolicy, size_t local_storage_align = alignof(::std::max_align_t)> class FunctionQueue;
+
+/** Multi-producer, single-consumer function queue template alias.
+**/
+template<class Any, size_t local_storage_size = 32, class Policy = UniquePolicy, size_t local_storage_align = alignof(::std::max_align_t)> using MpscFunctionQueue = FunctionQueue<Any, local_storage_size, false, Policy, local_storage_align>;
+
+/** Multi-producer, multi-consumer function queue template alias.
+**/
+template<class Any, size_t local_storage_size = 32, class Policy = UniquePolicy, size_t local_storage_align = alignof(::std::max_align_t)> using MpmcFunctionQueue = FunctionQueue<Any, local_storage_size, true, Policy, local_storage_align>;
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function queue template class, i.e. a bounded ring of function holders, each slot holding its closure in its local storage
+ * (or on the heap if it does not fit). Based on per-slot sequence numbers: producers (and, if several, consumers) claim
+ * positions with a compare-and-swap, then construct (resp. move out) the closure directly in the slot.
+ * @param Return(Args...)     Expected function type
+ * @param local_storage_size  Size reserved for the local storage of each slot (in bytes, optional)
+ * @param multi_consumer      Whether several threads can pop concurrently (optional)
+ * @param Policy              Holder policy (optional, move-only by default)
+ * @param local_storage_align Alignment of the local storage of each slot (in bytes, optional)
+**/
+template<class Return, class... Args, size_t local_storage_size, bool multi_consumer, class Policy, size_t local_storage_align> class FunctionQueue<Return(Args...), local_storage_size, multi_consumer, Policy, local_storage_align> final {
+public:
+    /** Function holder class of the queued functions.
+    **/
+    using Holder = Function<Return(Args...), local_storage_size, Policy, local_storage_align>;
+private:
+    static_assert(Holder::alignment <= alignof(::std::max_align_t), "Over-aligned slots are not supported");
+    constexpr static size_t line_size = 64; // Assumed cache line size
+    /** Ring slot.
+    **/
+    class Slot final {
+    public:
+        ::std::atomic<size_t> sequence; // Position the slot is ready for: to push if equal to the position, to pop if equal to the position plus one
+        Holder function; // Queued function (if any)
+    };
+    /** Position counter, alone in its cache line.
+    **/
+    template<class Counter> class Padded final {
+    public:
+        Counter value; // Position
+        uint8_t padding[line_size > sizeof(Counter) ? line_size - sizeof(Counter) : 1];
+    };
+private:
+    size_t mask; // Number of slots minus one
+    ::std::unique_ptr<Slot[]> slots; // Ring slots
+    Padded<::std::atomic<size_t>> tail; // Next position to push
+    Padded<::std::atomic<size_t>> head; // Next position to pop
+private:
+    /** Claim positions to pop.
+     * @param position Expected head position, updated on failure
+     * @param count    Number of positions to claim
+     * @return Whether the positions have been claimed
+    **/
+    bool claim(size_t& position, size_t count) noexcept {
+        if (!multi_consumer) { // Only the consumer updates the head
+            head.value.store(position + count, ::std::memory_order_relaxed);
+            return true;
+        }
+        return head.value.compare_exchange_weak(position, position + count, ::std::memory_order_relaxed);
+    }
+    /** Claim a position to push, then construct the function in its slot.
+     * @param construct Function constructing the holder in a slot
+     * @return Whether the function was pushed (false if the queue was full)
+    **/
+    template<class Construct> bool push(Construct&& construct) {
+        auto position = tail.value.load(::std::memory_order_relaxed);
+        while (true) {
+            auto& slot = slots[position & mask];
+            auto sequence = slot.sequence.load(::std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence - position);
+            if (diff == 0) { // Slot free for this position, try to claim it
+                if (tail.value.compare_exchange_weak(position, position + 1, ::std::memory_order_relaxed)) {
+                    ANYFUNCTION_TRY {
+                        construct(slot.function);
+                    } ANYFUNCTION_CATCH_ALL { // Publish the slot with no function, so consumers are not blocked
+                        slot.sequence.store(position + 1, ::std::memory_order_release);
+                        ANYFUNCTION_RETHROW;
+                    }
+                    slot.sequence.store(position + 1, ::std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) { // Slot not yet popped since the previous round, so full
+                return false;
+            } else { // Position already claimed by another producer
+                position = tail.value.load(::std::memory_order_relaxed);
+            }
+        }
+    }
+public:
+    /** Empty queue constructor.
+     * @param capacity Minimal number of slots, rounded up to a power of two
+    **/
+    explicit FunctionQueue(size_t capacity): mask(1) {
+        while (mask < capacity)
+            mask <<= 1;
+        slots.reset(new Slot[mask]);
+        for (size_t i = 0; i < mask; ++i)
+            slots[i].sequence.store(i, ::std::memory_order_relaxed);
+        --mask;
+        tail.value.store(0, ::std::memory_order_relaxed);
+        head.value.store(0, ::std::memory_order_relaxed);
+    }
+    FunctionQueue(FunctionQueue const&) = delete;
+    FunctionQueue& operator=(FunctionQueue const&) = delete;
+public:
+    /** Get the number of slots.
+     * @return Number of slots
+    **/
+    size_t capacity() const noexcept {
+        return mask + 1;
+    }
+    /** Get the number of queued functions, only approximate if producers/consumers are concurrently running.
+     * @return Number of queued functions
+    **/
+    size_t size() const noexcept {
+        auto first = head.value.load(::std::memory_order_relaxed);
+        auto last = tail.value.load(::std::memory_order_relaxed);
+        return last > first ? last - first : 0;
+    }
+    /** Push a function, copied/moved in its slot, lock-free.
+     * @param functor Function holder, standalone function or functor to copy/move
+     * @return Whether the function was pushed (false if the queue was full)
+    **/
+    template<class Functor> bool try_push(Functor&& functor) {
+        return push([&](Holder& function) {
+            function = ::std::forward<Functor>(functor);
+        });
+    }
+    /** Push a function, constructed in place in its slot, lock-free.
+     * @param Functor Functor class to construct
+     * @param ...     Functor constructor arguments
+     * @return Whether the function was pushed (false if the queue was full)
+    **/
+    template<class Functor, class... CtorArgs> bool try_emplace(CtorArgs&&... args) {
+        return push([&](Holder& function) {
+            function.template emplace<Functor>(::std::forward<CtorArgs>(args)...);
+        });
+    }
+    /** Pop functions in the push order, lock-free; single-consumer queues must only be popped from one thread at a time.
+     * @param functions Function holders to move the popped functions to
+     * @param count     Maximum number of functions to pop
+     * @return Number of popped functions (0 if the queue was empty)
+    **/
+    size_t try_pop_batch(Holder* functions, size_t count) {
+        if (count == 0)
+            return 0;
+        auto position = head.value.load(::std::memory_order_relaxed);
+        size_t ready;
+        while (true) { // Count the ready slots from the head, then claim them all at once
+            auto sequence = slots[position & mask].sequence.load(::std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence - (position + 1));
+            if (diff < 0) // First slot not pushed yet, so empty
+                return 0;
+            if (diff > 0) { // Head position already claimed by another consumer
+                position = head.value.load(::std::memory_order_relaxed);
+                continue;
+            }
+            for (ready = 1; ready < count; ++ready) {
+                auto& slot = slots[(position + ready) & mask];
+                if (slot.sequence.load(::std::memory_order_acquire) != position + ready + 1)
+                    break;
+            }
+            if (claim(position, ready))
+                break;
+        }
+        size_t i = 0;
+        ANYFUNCTION_TRY {
+            for (; i < ready; ++i) {
+                auto& slot = slots[(position + i) & mask];
+                functions[i] = ::std::move(slot.function); // Leaves the slot empty, can only throw if moved to another memory resource
+                slot.sequence.store(position + i + mask + 1, ::std::memory_order_release); // Free for the next round
+            }
+        } ANYFUNCTION_CATCH_ALL { // Drop the claimed functions not moved yet, and free their slots so the queue does not stall
+            for (; i < ready; ++i) {
+                auto& slot = slots[(position + i) & mask];
+                slot.function = nullptr;
+                slot.sequence.store(position + i + mask + 1, ::std::memory_order_release);
+            }
+            ANYFUNCTION_RETHROW;
+        }
+        return ready;
+    }
+    /** Pop one function, lock-free; single-consumer queues must only be popped from one thread at a time.
+     * @param function Function holder to move the popped function to
+     * @return Whether a function was popped (false if the queue was empty)
+    **/
+    bool try_pop(Holder& function) {
+        return try_pop_batch(&function, 1) != 0;
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Function queues ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
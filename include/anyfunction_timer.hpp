@@ -0,0 +1,423 @@
+/**
+ * @file   anyfunction_timer.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Hierarchical timing wheel, with timer callbacks stored inline in pooled intrusive nodes.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include "anyfunction.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Timing wheel ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Index of the lowest/highest set bit of a non-zero word.
+ * @param word Non-zero word
+ * @return Bit index
+**/
+inline size_t lowest_bit(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    size_t index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+inline size_t highest_bit(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - static_cast<size_t>(__builtin_clzll(word));
+#else
+    size_t index = 0;
+    while (word >>= 1)
+        ++index;
+    return index;
+#endif
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Hierarchical timing wheel, single-threaded, with time counted in abstract ticks.
+ * Each level has 64 slots covering 64 times the span of a slot of the level below, plus an overflow list beyond the last level;
+ * each slot is an intrusive list of pooled nodes, each node holding its callback inline.
+ * Scheduling and cancellation are O(1); expiry cascades the nodes of a slot into the lower levels by relinking them,
+ * and slot occupancy bitmaps let 'advance' jump over empty stretches of time.
+ * @param local_storage_size Size reserved for the local storage of each callback (in bytes, optional)
+**/
+template<size_t local_storage_size = 32> class TimingWheel final {
+public:
+    /** Timer callback holder class.
+    **/
+    using Task = UniqueFunction<void(), local_storage_size>;
+    /** Handle on a scheduled timer, invalidated when the timer fires or is cancelled.
+    **/
+    class Timer final {
+        friend class TimingWheel;
+    private:
+        uint32_t index; // Node index in the pool
+        uint32_t generation; // Node generation when scheduled
+    public:
+        /** Invalid handle constructor.
+        **/
+        Timer() noexcept: index(0), generation(0) {}
+    private:
+        Timer(uint32_t index, uint32_t generation) noexcept: index(index), generation(generation) {}
+    };
+    constexpr static size_t level_bits = 6; // Number of tick bits per level
+    constexpr static size_t nb_slots   = size_t{1} << level_bits; // Number of slots per level
+    constexpr static size_t nb_levels  = 6; // Number of levels, before the overflow list
+    constexpr static size_t chunk_size = 1024; // Number of nodes per pool chunk
+private:
+    constexpr static uint64_t slot_mask = nb_slots - 1;
+    constexpr static uint8_t overflow_level = nb_levels; // Level of the nodes in the overflow list
+    /** Intrusive circular list link, also used as list head.
+    **/
+    class Link {
+    public:
+        Link* prev;
+        Link* next;
+    };
+    /** Pooled timer node.
+    **/
+    class Node final: public Link {
+    public:
+        Task task; // Callback, empty when the node is free
+        uint64_t expiry; // Expiry tick
+        uint32_t index; // Index in the pool
+        uint32_t generation = 1; // Incremented each time the node is freed
+        uint8_t level; // Wheel level, or 'overflow_level'
+        uint8_t slot; // Slot in the wheel level
+    };
+private:
+    Link wheel[nb_levels][nb_slots]; // Slot lists
+    uint64_t occupied[nb_levels]; // Non-empty slots, per level
+    Link overflow; // Nodes beyond the last level
+    Link firing; // Nodes being fired
+    ::std::vector<::std::unique_ptr<Node[]>> chunks; // Node pool
+    Node* free_nodes; // Free node list, chained through 'next'
+    uint64_t current; // Current tick
+    size_t count; // Number of pending timers
+private:
+    /** Initialize a list head as empty.
+     * @param head List head
+    **/
+    static void reset(Link& head) noexcept {
+        head.prev = &head;
+        head.next = &head;
+    }
+    /** Tell whether a list is empty.
+     * @param head List head
+     * @return Whether the list is empty
+    **/
+    static bool empty(Link const& head) noexcept {
+        return head.next == &head;
+    }
+    /** Append a link at the end of a list.
+     * @param head List head
+     * @param link Link to append
+    **/
+    static void append(Link& head, Link& link) noexcept {
+        link.prev = head.prev;
+        link.next = &head;
+        head.prev->next = &link;
+        head.prev = &link;
+    }
+    /** Remove a link from its list.
+     * @param link Link to remove
+    **/
+    static void unlink(Link& link) noexcept {
+        link.prev->next = link.next;
+        link.next->prev = link.prev;
+    }
+    /** Move all the links of a list at the end of another.
+     * @param from List head to empty
+     * @param to   List head to append to
+    **/
+    static void splice(Link& from, Link& to) noexcept {
+        if (empty(from))
+            return;
+        from.next->prev = to.prev;
+        to.prev->next = from.next;
+        from.prev->next = &to;
+        to.prev = from.prev;
+        reset(from);
+    }
+    /** Take a free node from the pool, growing it by a chunk if needed.
+     * @return Free node
+    **/
+    Node& acquire() {
+        if (!free_nodes) {
+            auto base = chunks.size() * chunk_size;
+            if (base + chunk_size > static_cast<size_t>(static_cast<uint32_t>(-1))) // Node indexes must fit in handles
+                Exception::raise<::std::bad_alloc>();
+            ::std::unique_ptr<Node[]> chunk{new Node[chunk_size]};
+            chunks.push_back(::std::move(chunk));
+            for (size_t i = chunk_size; i-- > 0;) {
+                auto& node = chunks.back()[i];
+                node.index = static_cast<uint32_t>(base + i);
+                node.next = free_nodes;
+                free_nodes = &node;
+            }
+        }
+        auto& node = *free_nodes;
+        free_nodes = static_cast<Node*>(node.next);
+        return node;
+    }
+    /** Give back a node to the pool, invalidating its handles.
+     * @param node Node with an empty callback
+    **/
+    void release(Node& node) noexcept {
+        ++node.generation;
+        node.next = free_nodes;
+        free_nodes = &node;
+    }
+    /** Get the node of a handle, if the timer is still pending.
+     * @param timer Timer handle
+     * @return Pointer on the node, null if invalid
+    **/
+    Node* find(Timer timer) const noexcept {
+        auto chunk = timer.index / chunk_size;
+        if (chunk >= chunks.size())
+            return nullptr;
+        auto& node = chunks[chunk][timer.index % chunk_size];
+        return node.generation == timer.generation ? &node : nullptr;
+    }
+    /** Link a node in the slot matching its expiry, relative to the current tick.
+     * @param node Node to link, with 'expiry >= current'
+    **/
+    void place(Node& node) noexcept {
+        auto diff = node.expiry ^ current;
+        size_t level = diff ? highest_bit(diff) / level_bits : 0;
+        if (level >= nb_levels) {
+            node.level = overflow_level;
+            append(overflow, node);
+            return;
+        }
+        auto slot = static_cast<size_t>((node.expiry >> (level * level_bits)) & slot_mask);
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        append(wheel[level][slot], node);
+        occupied[level] |= uint64_t{1} << slot;
+    }
+    /** Unlink a node from its slot (or from the overflow or firing list).
+     * @param node Node to unlink
+    **/
+    void remove(Node& node) noexcept {
+        unlink(node);
+        if (node.level < nb_levels && empty(wheel[node.level][node.slot]))
+            occupied[node.level] &= ~(uint64_t{1} << node.slot);
+    }
+    /** Relink every node of a list relative to the current tick, the callbacks are left in place.
+     * @param head List head
+    **/
+    void cascade(Link& head) noexcept {
+        Link list;
+        reset(list);
+        splice(head, list);
+        while (!empty(list)) {
+            auto& node = static_cast<Node&>(*list.next);
+            unlink(node);
+            place(node);
+        }
+    }
+    /** Get the next tick where a slot expires or cascades, bounded by a target tick.
+     * @param target Target tick, greater than the current one
+     * @return Next event tick
+    **/
+    uint64_t next_event(uint64_t target) const noexcept {
+        auto next = target;
+        for (size_t level = 0; level < nb_levels; ++level) {
+            auto shift = level * level_bits;
+            auto group = (current >> shift) & slot_mask;
+            auto later = occupied[level] & ((~uint64_t{0} << group) << 1); // Slots after the current one, earlier ones are empty
+            if (later) {
+                auto base = (current >> (shift + level_bits)) << (shift + level_bits);
+                auto tick = base + (static_cast<uint64_t>(lowest_bit(later)) << shift);
+                if (tick < next)
+                    next = tick;
+            }
+        }
+        if (!empty(overflow)) {
+            constexpr auto shift = nb_levels * level_bits;
+            auto tick = ((current >> shift) + 1) << shift;
+            if (tick > current && tick < next)
+                next = tick;
+        }
+        return next;
+    }
+    /** Fire the timers of the current tick, including the ones scheduled for it by the fired callbacks.
+     * @return Number of fired timers
+    **/
+    size_t fire() {
+        auto slot = static_cast<size_t>(current & slot_mask);
+        size_t fired = 0;
+        while (occupied[0] & (uint64_t{1} << slot)) {
+            splice(wheel[0][slot], firing);
+            occupied[0] &= ~(uint64_t{1} << slot);
+            while (!empty(firing)) {
+                auto& node = static_cast<Node&>(*firing.next);
+                unlink(node);
+                Task task{::std::move(node.task)}; // Relocated out, so the node can be reused by the callback
+                release(node);
+                --count;
+                ++fired;
+                ANYFUNCTION_TRY {
+                    task();
+                } ANYFUNCTION_CATCH_ALL {
+                    if (!empty(firing)) { // Put back the remaining timers first, fired by the next 'advance'
+                        splice(wheel[0][slot], firing);
+                        splice(firing, wheel[0][slot]);
+                        occupied[0] |= uint64_t{1} << slot;
+                    }
+                    ANYFUNCTION_RETHROW;
+                }
+            }
+        }
+        return fired;
+    }
+public:
+    /** Empty wheel constructor.
+     * @param start Initial tick (optional)
+    **/
+    explicit TimingWheel(uint64_t start = 0) noexcept: free_nodes(nullptr), current(start), count(0) {
+        for (size_t level = 0; level < nb_levels; ++level) {
+            for (auto& head: wheel[level])
+                reset(head);
+            occupied[level] = 0;
+        }
+        reset(overflow);
+        reset(firing);
+    }
+    TimingWheel(TimingWheel const&) = delete;
+    TimingWheel& operator=(TimingWheel const&) = delete;
+public:
+    /** Get the current tick.
+     * @return Current tick
+    **/
+    uint64_t now() const noexcept {
+        return current;
+    }
+    /** Get the number of pending timers.
+     * @return Number of pending timers
+    **/
+    size_t size() const noexcept {
+        return count;
+    }
+    /** Tell whether a timer is still pending.
+     * @param timer Timer handle
+     * @return Whether the timer is pending
+    **/
+    bool pending(Timer timer) const noexcept {
+        return find(timer) != nullptr;
+    }
+    /** Schedule a callback at the given tick, constructed in place in a pooled node.
+     * @param expiry  Expiry tick, the current tick if in the past
+     * @param functor Callback to copy/move
+     * @return Timer handle
+    **/
+    template<class Functor> Timer schedule_at(uint64_t expiry, Functor&& functor) {
+        auto& node = acquire();
+        ANYFUNCTION_TRY {
+            node.task.template emplace<typename ::std::decay<Functor>::type>(::std::forward<Functor>(functor));
+        } ANYFUNCTION_CATCH_ALL {
+            node.next = free_nodes;
+            free_nodes = &node;
+            ANYFUNCTION_RETHROW;
+        }
+        node.expiry = expiry < current ? current : expiry;
+        place(node);
+        ++count;
+        return Timer{node.index, node.generation};
+    }
+    /** Schedule a callback after the given number of ticks.
+     * @param delay   Number of ticks from the current one
+     * @param functor Callback to copy/move
+     * @return Timer handle
+    **/
+    template<class Functor> Timer schedule(uint64_t delay, Functor&& functor) {
+        auto expiry = current + delay;
+        return schedule_at(expiry < current ? ~uint64_t{0} : expiry, ::std::forward<Functor>(functor));
+    }
+    /** Cancel a pending timer, destroying its callback.
+     * @param timer Timer handle
+     * @return Whether the timer was pending
+    **/
+    bool cancel(Timer timer) noexcept {
+        auto node = find(timer);
+        if (!node)
+            return false;
+        remove(*node);
+        node->task.clear();
+        release(*node);
+        --count;
+        return true;
+    }
+    /** Advance the current tick, firing the expired timers in expiry order.
+     * A callback can schedule and cancel timers; if it throws, the current tick is the one of the throwing timer.
+     * @param target Target tick, nothing is done if in the past
+     * @return Number of fired timers
+    **/
+    size_t advance(uint64_t target) {
+        if (target < current)
+            return 0;
+        size_t fired = fire();
+        while (current < target) {
+            current = next_event(target);
+            if ((current & ((uint64_t{1} << (nb_levels * level_bits)) - 1)) == 0)
+                cascade(overflow);
+            for (auto level = nb_levels - 1; level > 0; --level) { // Cascade top-down the levels aligned on the new tick
+                auto shift = level * level_bits;
+                if ((current & ((uint64_t{1} << shift) - 1)) != 0)
+                    continue;
+                auto slot = static_cast<size_t>((current >> shift) & slot_mask);
+                if (occupied[level] & (uint64_t{1} << slot)) {
+                    occupied[level] &= ~(uint64_t{1} << slot);
+                    cascade(wheel[level][slot]);
+                }
+            }
+            fired += fire();
+        }
+        return fired;
+    }
+};
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
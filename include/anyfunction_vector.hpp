@@ -0,0 +1,409 @@
+/**
+ * @file   anyfunction_vector.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Contiguous function container, packing closures back to back in one arena.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include "anyfunction.hpp"
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Function vector ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace AnyFunction {
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function container template class.
+ * @param Return(Args...) Expected function type
+**/
+template<class Any> class FunctionVector;
+
+/** Function container, packing closures of any size back to back in one arena (structure of arrays: invokers, offsets and managers are separate dense arrays).
+ * Removal is O(1), by handle: the last function takes the place of the removed one, and the arena is compacted once mostly made of removed closures.
+ * @param Return  Return type
+ * @param Args... Argument types
+**/
+template<class Return, class... Args> class FunctionVector<Return(Args...)> final {
+private:
+    /** Types of function/helpers used.
+    **/
+    using Invoker = invoker_t<Return, Args...>;
+    using Manager = Operations<Invoker> const*;
+    constexpr static uintptr_t remote_tag = 1; // Manager pointer tag of heap-stored functors (see 'Function')
+    constexpr static size_t alignment = alignof(::std::max_align_t); // Arena alignment
+    constexpr static size_t min_arena = 256; // Minimal arena size (in bytes)
+public:
+    /** Handle of a function in the container, default-constructed as invalid.
+    **/
+    class Handle final {
+        friend class FunctionVector;
+    private:
+        size_t slot; // Slot index
+        size_t generation; // Slot generation (0 for none)
+    public:
+        constexpr Handle() noexcept: slot(0), generation(0) {}
+    private:
+        constexpr Handle(size_t slot, size_t generation) noexcept: slot(slot), generation(generation) {}
+    public:
+        bool operator==(Handle const& other) const noexcept {
+            return slot == other.slot && generation == other.generation;
+        }
+        bool operator!=(Handle const& other) const noexcept {
+            return !(*this == other);
+        }
+    };
+private:
+    /** Handle slot.
+    **/
+    class Slot final {
+    public:
+        size_t position; // Position in the dense arrays
+        size_t generation; // Current generation, incremented by each removal
+    };
+private:
+    unsigned char* arena; // Packed closures (or pointers to heap-stored closures)
+    size_t capacity; // Arena size (in bytes)
+    size_t used; // End of the last packed closure (in bytes)
+    size_t garbage; // Size of the removed closures (in bytes)
+    ::std::vector<Invoker> invokers; // Invoker per function
+    ::std::vector<size_t> offsets; // Arena offset per function
+    ::std::vector<uintptr_t> managers; // Manager per function, tagged with 'remote_tag' if heap-stored
+    ::std::vector<size_t> owners; // Slot index per function
+    ::std::vector<Slot> slots; // Slot per handle
+    ::std::vector<size_t> free_slots; // Indexes of the unused slots
+private:
+    /** Get the manager of a function, and whether it is heap-stored.
+     * @param position Function position
+     * @return Manager/Whether heap-stored
+    **/
+    Manager get_manager(size_t position) const noexcept {
+        return reinterpret_cast<Manager>(managers[position] & ~remote_tag);
+    }
+    bool is_remote(size_t position) const noexcept {
+        return (managers[position] & remote_tag) != 0;
+    }
+    /** Get the size and alignment taken in the arena by a function.
+     * @param position Function position
+     * @return Size/alignment (in bytes)
+    **/
+    size_t size_of(size_t position) const noexcept {
+        return is_remote(position) ? sizeof(void*) : get_manager(position)->size;
+    }
+    size_t align_of(size_t position) const noexcept {
+        return is_remote(position) ? alignof(void*) : get_manager(position)->align;
+    }
+    /** Round an offset up to an alignment.
+     * @param offset Offset to round up
+     * @param align  Alignment, a power of two
+     * @return Rounded offset
+    **/
+    constexpr static size_t align_up(size_t offset, size_t align) noexcept {
+        return (offset + align - 1) & ~(align - 1);
+    }
+    /** Destroy a function, leaving its arena space unused.
+     * @param position Function position
+    **/
+    void destroy(size_t position) noexcept {
+        auto instance = arena + offsets[position];
+        if (is_remote(position)) {
+            get_manager(position)->free(*reinterpret_cast<void**>(instance));
+        } else {
+            get_manager(position)->destroy(instance);
+        }
+    }
+    /** Get the arena size needed to pack all the functions back to back in call order.
+     * Removals change the call order, so the padding between closures can differ from the current layout.
+     * @return Packed size (in bytes)
+    **/
+    size_t packed_size() const noexcept {
+        size_t cursor = 0;
+        for (size_t i = 0; i < offsets.size(); ++i)
+            cursor = align_up(cursor, align_of(i)) + size_of(i);
+        return cursor;
+    }
+    /** Move all the functions to a new arena, packed back to back in call order.
+     * @param size New arena size (in bytes), enlarged to the packed size of the functions if smaller
+    **/
+    void relocate(size_t size) {
+        size = ::std::max(size, packed_size());
+        auto target = static_cast<unsigned char*>(::operator new(size)); // Can throw
+        size_t cursor = 0;
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            auto offset = align_up(cursor, align_of(i));
+            auto source = arena + offsets[i];
+            auto manager = get_manager(i);
+            if (is_remote(i) || manager->relocatable) {
+                ::std::memcpy(target + offset, source, size_of(i));
+            } else { // Nothrow move constructor, checked at insertion
+                manager->move_construct(target + offset, source);
+                manager->destroy(source);
+            }
+            offsets[i] = offset;
+            cursor = offset + size_of(i);
+        }
+        ::operator delete(arena);
+        arena = target;
+        capacity = size;
+        used = cursor;
+        garbage = 0;
+    }
+    /** Make room for one more element in a dense array, growing it geometrically.
+     * @param array Dense array to grow
+    **/
+    template<class Type> static void grow(::std::vector<Type>& array) {
+        if (array.size() == array.capacity())
+            array.reserve(::std::max<size_t>(8, 2 * array.size()));
+    }
+    /** Make room for one more function, compacting the arena if mostly made of removed closures.
+     * @param size  Closure size (in bytes)
+     * @param align Closure alignment
+     * @return Arena offset to construct the closure at
+    **/
+    size_t prepare(size_t size, size_t align) {
+        auto offset = align_up(used, align);
+        if (offset + size > capacity || garbage * 2 > used) {
+            relocate(::std::max(min_arena, 2 * (packed_size() + size + align))); // Can throw
+            offset = align_up(used, align);
+        }
+        grow(invokers); // Reserve now, so that no push after construction can throw
+        grow(offsets);
+        grow(managers);
+        grow(owners);
+        if (free_slots.empty()) { // One more slot, that can be freed later
+            grow(slots);
+            free_slots.reserve(slots.capacity());
+        }
+        return offset;
+    }
+    /** Register a constructed function.
+     * @param invoker Invoker to use
+     * @param manager Manager, tagged with 'remote_tag' if heap-stored
+     * @param offset  Arena offset of the closure
+     * @param size    Arena size of the closure (in bytes)
+     * @return Handle of the function
+    **/
+    Handle commit(Invoker invoker, uintptr_t manager, size_t offset, size_t size) noexcept {
+        size_t slot;
+        if (free_slots.empty()) {
+            slot = slots.size();
+            slots.push_back(Slot{0, 1});
+        } else {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        slots[slot].position = invokers.size();
+        invokers.push_back(invoker);
+        offsets.push_back(offset);
+        managers.push_back(manager);
+        owners.push_back(slot);
+        used = offset + size;
+        return Handle{slot, slots[slot].generation};
+    }
+public:
+    /** Empty container constructor.
+    **/
+    FunctionVector() noexcept: arena(nullptr), capacity(0), used(0), garbage(0) {}
+    /** Move constructor/assignment, the moved-from container is left empty.
+     * @param other Container to move
+     * @return Current instance
+    **/
+    FunctionVector(FunctionVector&& other) noexcept: FunctionVector() {
+        swap(other);
+    }
+    FunctionVector& operator=(FunctionVector&& other) noexcept {
+        FunctionVector{::std::move(other)}.swap(*this);
+        return *this;
+    }
+    FunctionVector(FunctionVector const&) = delete;
+    /** Destroy all the functions.
+    **/
+    ~FunctionVector() {
+        clear();
+        ::operator delete(arena);
+    }
+public:
+    /** Swap with another container.
+     * @param other Container to swap with
+    **/
+    void swap(FunctionVector& other) noexcept {
+        ::std::swap(arena, other.arena);
+        ::std::swap(capacity, other.capacity);
+        ::std::swap(used, other.used);
+        ::std::swap(garbage, other.garbage);
+        invokers.swap(other.invokers);
+        offsets.swap(other.offsets);
+        managers.swap(other.managers);
+        owners.swap(other.owners);
+        slots.swap(other.slots);
+        free_slots.swap(other.free_slots);
+    }
+    /** Get the number of functions.
+     * @return Number of functions
+    **/
+    size_t size() const noexcept {
+        return invokers.size();
+    }
+    bool empty() const noexcept {
+        return invokers.empty();
+    }
+    /** Get the arena size and its part holding functions, or removed closures awaiting compaction.
+     * @return Size (in bytes)
+    **/
+    size_t arena_capacity() const noexcept {
+        return capacity;
+    }
+    size_t arena_used() const noexcept {
+        return used - garbage;
+    }
+    /** Reserve room for functions, compacting the arena.
+     * @param count Number of functions
+     * @param bytes Total arena size of their closures (in bytes)
+    **/
+    void reserve(size_t count, size_t bytes) {
+        invokers.reserve(count);
+        offsets.reserve(count);
+        managers.reserve(count);
+        owners.reserve(count);
+        if (bytes > used - garbage)
+            relocate(::std::max(min_arena, bytes));
+    }
+    /** Compact the arena, releasing the space of the removed closures.
+    **/
+    void shrink_to_fit() {
+        relocate(::std::max(min_arena, used - garbage));
+    }
+    /** Insert a function, constructed in place in the arena.
+     * @param Functor Functor class to construct
+     * @param ...     Functor constructor arguments
+     * @return Handle of the function
+    **/
+    template<class Functor, class... CtorArgs> Handle emplace(CtorArgs&&... args) {
+        static_assert(::std::is_same<Functor, typename ::std::decay<Functor>::type>::value, "'Functor' must be a non-reference, non-const class");
+        { // Check functor callability
+            using ResultOf = typename ::std::result_of<Functor(Args...)>::type; // Since C++14, not defined if function can not be called with the arguments
+            static_assert(::std::is_same<Return, ResultOf>::value || ::std::is_base_of<Return, ResultOf>::value, "'Functor' result type is incompatible"); // '::std::is_same' needed for fundamental types
+        }
+        Manager manager = &specialized_operations<Functor, false, Return, Args...>::value;
+        constexpr bool local = (::std::is_nothrow_move_constructible<Functor>::value || is_trivially_relocatable<Functor>::value) && alignof(Functor) <= alignment; // Movable when relocating the arena
+        if (local) {
+            auto offset = prepare(sizeof(Functor), alignof(Functor)); // Can throw
+            new(arena + offset) Functor(::std::forward<CtorArgs>(args)...); // Can throw
+            return commit(manager->local_invoker, reinterpret_cast<uintptr_t>(manager), offset, sizeof(Functor));
+        } else {
+            auto offset = prepare(sizeof(void*), alignof(void*)); // Can throw
+            *reinterpret_cast<void**>(arena + offset) = new Functor(::std::forward<CtorArgs>(args)...); // Can throw
+            return commit(manager->remote_invoker, reinterpret_cast<uintptr_t>(manager) | remote_tag, offset, sizeof(void*));
+        }
+    }
+    /** Insert a function.
+     * @param functor Function holder, standalone function or functor to copy/move
+     * @return Handle of the function
+    **/
+    template<class Functor> Handle insert(Functor&& functor) {
+        return emplace<typename ::std::decay<Functor>::type>(::std::forward<Functor>(functor));
+    }
+    /** Check whether a handle refers to a function of this container.
+     * @param handle Handle to check
+     * @return True if valid, false if default-constructed or its function was removed
+    **/
+    bool contains(Handle const& handle) const noexcept {
+        return handle.slot < slots.size() && handle.generation != 0 && slots[handle.slot].generation == handle.generation;
+    }
+    /** Remove a function, moving the last function to its position.
+     * @param handle Handle of the function to remove
+     * @return Whether a function was removed (false if the handle was not valid)
+    **/
+    bool erase(Handle const& handle) noexcept {
+        if (!contains(handle))
+            return false;
+        auto position = slots[handle.slot].position;
+        garbage += size_of(position);
+        destroy(position);
+        auto last = invokers.size() - 1;
+        if (position != last) {
+            invokers[position] = invokers[last];
+            offsets[position] = offsets[last];
+            managers[position] = managers[last];
+            owners[position] = owners[last];
+            slots[owners[position]].position = position;
+        }
+        invokers.pop_back();
+        offsets.pop_back();
+        managers.pop_back();
+        owners.pop_back();
+        ++slots[handle.slot].generation; // Invalidate the handle
+        free_slots.push_back(handle.slot); // Reserved at insertion
+        if (invokers.empty()) { // Arena entirely free
+            used = 0;
+            garbage = 0;
+        }
+        return true;
+    }
+    /** Remove all the functions, invalidating all the handles.
+    **/
+    void clear() noexcept {
+        for (size_t i = 0; i < invokers.size(); ++i) {
+            destroy(i);
+            ++slots[owners[i]].generation; // Invalidate the handle
+            free_slots.push_back(owners[i]); // Reserved at insertion
+        }
+        invokers.clear();
+        offsets.clear();
+        managers.clear();
+        owners.clear();
+        used = 0;
+        garbage = 0;
+    }
+    /** Call every function with the same arguments, in container order; functions must not modify the container.
+     * @param ... Arguments, values not cheap to copy being copied for each function
+    **/
+    void operator()(Args... args) {
+        auto invoker = invokers.data();
+        auto offset = offsets.data();
+        auto count = invokers.size();
+        for (size_t i = 0; i < count; ++i)
+            invoker[i](arena + offset[i], broadcast_t<Args>(args)...);
+    }
+};
+template<class Return, class... Args> constexpr size_t FunctionVector<Return(Args...)>::min_arena;
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Function vector ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,144 @@
+/**
+ * @file   batch.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Batch invocation benchmarks, against plain loops of calls.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include <anyfunction_batch.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Closures ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Trivially copyable closure of one of several classes, updating its argument.
+ * @param kind Closure class index
+**/
+template<size_t kind> class Kind final {
+private:
+    float scale; // Captured state
+public:
+    Kind() noexcept: scale(1.0f / (kind + 2)) {}
+    void operator()(float& x) const noexcept {
+        x = x * scale + kind;
+    }
+};
+
+/** Append a closure of the given class index, among 8.
+ * @param funcs Function object holders to append to
+ * @param kind  Closure class index
+**/
+template<class Holders> static void append(Holders& funcs, size_t kind) {
+    switch (kind) {
+    case 0: funcs.emplace_back(Kind<0>{}); break;
+    case 1: funcs.emplace_back(Kind<1>{}); break;
+    case 2: funcs.emplace_back(Kind<2>{}); break;
+    case 3: funcs.emplace_back(Kind<3>{}); break;
+    case 4: funcs.emplace_back(Kind<4>{}); break;
+    case 5: funcs.emplace_back(Kind<5>{}); break;
+    case 6: funcs.emplace_back(Kind<6>{}); break;
+    default: funcs.emplace_back(Kind<7>{}); break;
+    }
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Closures ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Benchmark calling holders of randomly mixed closure classes with the same arguments.
+ * @param nb_kinds Number of closure classes (at most 8)
+**/
+static void bench_invoke_all(size_t nb_kinds) {
+    constexpr static size_t count = 4096;
+    auto params = "kinds=" + ::std::to_string(nb_kinds);
+    ::std::vector<Function<void(float&)>> funcs;
+    ::std::mt19937 random{42};
+    ::std::uniform_int_distribution<size_t> pick{0, nb_kinds - 1};
+    for (size_t i = 0; i < count; ++i)
+        append(funcs, pick(random));
+    Bench::measure("batch", "invoke_all", params.c_str(), "loop", [&]() {
+        float x = 0;
+        for (auto&& func: funcs)
+            func(x);
+        Bench::keep(x);
+    }, count);
+    Bench::measure("batch", "invoke_all", params.c_str(), "invoke_all", [&]() {
+        float x = 0;
+        invoke_all(funcs, x);
+        Bench::keep(x);
+    }, count);
+    BatchCalls<void(float&)> batch{funcs};
+    Bench::measure("batch", "invoke_all", params.c_str(), "BatchCalls", [&]() { // Grouped once
+        float x = 0;
+        batch(x);
+        Bench::keep(x);
+    }, count);
+}
+
+/** Benchmark calling one holder over many argument sets.
+**/
+static void bench_invoke_each() {
+    constexpr static size_t count = 4096;
+    Function<float(float, float)> func = [](float x, float y) { return x * y + 1; };
+    ::std::vector<::std::tuple<float, float>> tuples;
+    for (size_t i = 0; i < count; ++i)
+        tuples.emplace_back(static_cast<float>(i), 0.5f);
+    ::std::vector<float> results(count);
+    Bench::measure("batch", "invoke_each", "pairs", "loop", [&]() {
+        auto result = results.begin();
+        for (auto&& tuple: tuples)
+            *result++ = func(::std::get<0>(tuple), ::std::get<1>(tuple));
+        Bench::keep(results);
+    }, count);
+    Bench::measure("batch", "invoke_each", "pairs", "invoke_each", [&]() {
+        invoke_each(func, tuples, results.begin());
+        Bench::keep(results);
+    }, count);
+}
+
+/** Batch invocation benchmark suite.
+**/
+static void bench_batch() {
+    bench_invoke_all(1);
+    bench_invoke_all(2);
+    bench_invoke_all(8);
+    bench_invoke_each();
+}
+static Bench::Register register_batch{"batch", bench_batch};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,113 @@
+/**
+ * @file   bench.hpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Microbenchmark harness: measures and reports (as CSV) time and allocations per operation.
+**/
+
+#pragma once
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <chrono>
+#include <cstddef>
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Harness ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+namespace Bench {
+
+/** Benchmark suite, running all its measures.
+**/
+using Suite = void (*)();
+
+/** Benchmark suite registration, at static initialization.
+**/
+class Register final {
+public:
+    /** Register a benchmark suite.
+     * @param name Suite name, used to select suites to run
+     * @param run  Suite function
+    **/
+    Register(char const* name, Suite run);
+};
+
+/** Get the number of allocations made so far (through the global operator 'new', by any thread).
+ * @return Number of allocations
+**/
+size_t allocations() noexcept;
+
+/** Report one measure, as one CSV line.
+ * @param suite  Suite name
+ * @param name   Measured operation name
+ * @param params Operation parameters (e.g. closure size)
+ * @param impl   Implementation name
+ * @param ns     Time per operation, in ns
+ * @param allocs Allocations per operation
+**/
+void report(char const* suite, char const* name, char const* params, char const* impl, double ns, double allocs);
+
+/** Prevent the compiler from optimizing away the computation of a value.
+ * @param value Value to keep
+**/
+template<class Type> inline void keep(Type const& value) noexcept {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/** Measure an operation (best of several runs, after calibration), then report it.
+ * @param suite  Suite name
+ * @param name   Measured operation name
+ * @param params Operation parameters (e.g. closure size)
+ * @param impl   Implementation name
+ * @param op     Operation to measure, called once per iteration
+ * @param ops    Number of operations per call of 'op' (optional)
+**/
+template<class Op> void measure(char const* suite, char const* name, char const* params, char const* impl, Op&& op, size_t ops = 1) {
+    using Clock = ::std::chrono::steady_clock;
+    constexpr static double min_duration = 1e7; // Minimal duration of a run, in ns
+    constexpr static size_t nb_runs = 3; // Number of measured runs
+    auto run = [&](size_t iterations, size_t& allocs) -> double { // Duration of the run, in ns
+        auto before = allocations();
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+            op();
+        auto stop = Clock::now();
+        allocs = allocations() - before;
+        return ::std::chrono::duration<double, ::std::nano>(stop - start).count();
+    };
+    size_t iterations = 1;
+    size_t allocs;
+    while (run(iterations, allocs) < min_duration) // Calibration
+        iterations *= 2;
+    double best = run(iterations, allocs);
+    for (size_t i = 1; i < nb_runs; ++i) {
+        auto duration = run(iterations, allocs);
+        if (duration < best)
+            best = duration;
+    }
+    report(suite, name, params, impl, best / (iterations * ops), static_cast<double>(allocs) / (iterations * ops));
+}
+
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Harness ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,183 @@
+/**
+ * @file   executor.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Executor benchmarks, against a thread pool sharing a locked 'std::deque' of 'std::function'.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Internal headers
+#include <anyfunction_executor.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Pools ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Thread pool sharing a locked 'std::deque' of 'std::function', for reference.
+**/
+class LockedPool final {
+private:
+    ::std::mutex lock; // Queue lock
+    ::std::condition_variable ready; // Task or stop condition
+    ::std::condition_variable idle; // No pending task condition
+    ::std::deque<::std::function<void()>> queue; // Shared queue
+    size_t pending; // Posted tasks not yet completed
+    bool stopping; // Whether the workers must stop
+    ::std::vector<::std::thread> workers; // Worker threads
+public:
+    LockedPool(size_t nb_workers): pending(0), stopping(false) {
+        for (size_t i = 0; i < nb_workers; ++i) {
+            workers.emplace_back([this]() {
+                ::std::unique_lock<::std::mutex> guard{lock};
+                while (true) {
+                    ready.wait(guard, [&]() { return stopping || !queue.empty(); });
+                    if (queue.empty())
+                        return;
+                    auto task = ::std::move(queue.front());
+                    queue.pop_front();
+                    guard.unlock();
+                    task();
+                    task = nullptr;
+                    guard.lock();
+                    if (--pending == 0)
+                        idle.notify_all();
+                }
+            });
+        }
+    }
+    ~LockedPool() {
+        {
+            ::std::lock_guard<::std::mutex> guard{lock};
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto&& worker: workers)
+            worker.join();
+    }
+    template<class Functor> void post(Functor&& functor) {
+        {
+            ::std::lock_guard<::std::mutex> guard{lock};
+            queue.emplace_back(::std::forward<Functor>(functor));
+            ++pending;
+        }
+        ready.notify_one();
+    }
+    void wait_idle() {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        idle.wait(guard, [&]() { return pending == 0; });
+    }
+};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Pools ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Fork-join task: posts two children until the leaves, which are counted.
+ * @param Pool Thread pool class
+**/
+template<class Pool> class Fork final {
+public:
+    Pool* pool; // Pool to post the children to
+    ::std::atomic<size_t>* leaves; // Leaf counter
+    size_t depth; // Remaining depth
+public:
+    void operator()() const {
+        if (depth == 0) {
+            leaves->fetch_add(1, ::std::memory_order_relaxed);
+            return;
+        }
+        pool->post(Fork{pool, leaves, depth - 1});
+        pool->post(Fork{pool, leaves, depth - 1});
+    }
+};
+
+/** Benchmark a binary fork-join tree of tasks, posted from the workers.
+ * @param Pool       Thread pool class
+ * @param impl       Implementation name
+ * @param nb_workers Number of worker threads
+**/
+template<class Pool> static void bench_fork_join(char const* impl, size_t nb_workers) {
+    constexpr static size_t depth = 13;
+    constexpr static size_t nb_tasks = (size_t{2} << depth) - 1; // Tasks run per measure
+    auto params = "workers=" + ::std::to_string(nb_workers);
+    Pool pool{nb_workers};
+    Bench::measure("executor", "fork_join", params.c_str(), impl, [&]() {
+        ::std::atomic<size_t> leaves{0};
+        pool.post(Fork<Pool>{&pool, &leaves, depth});
+        pool.wait_idle();
+        Bench::keep(leaves.load());
+    }, nb_tasks);
+}
+
+/** Benchmark a fan-out of independent tasks, posted from the calling thread.
+ * @param Pool       Thread pool class
+ * @param impl       Implementation name
+ * @param nb_workers Number of worker threads
+**/
+template<class Pool> static void bench_fan_out(char const* impl, size_t nb_workers) {
+    constexpr static size_t nb_tasks = 1 << 14; // Tasks run per measure
+    auto params = "workers=" + ::std::to_string(nb_workers);
+    Pool pool{nb_workers};
+    Bench::measure("executor", "fan_out", params.c_str(), impl, [&]() {
+        ::std::atomic<size_t> sum{0};
+        for (size_t i = 0; i < nb_tasks; ++i)
+            pool.post([&sum, i]() { sum.fetch_add(i, ::std::memory_order_relaxed); });
+        pool.wait_idle();
+        Bench::keep(sum.load());
+    }, nb_tasks);
+}
+
+/** Executor benchmark suite.
+**/
+static void bench_executors() {
+    auto nb_threads = static_cast<size_t>(::std::thread::hardware_concurrency());
+    ::std::vector<size_t> counts{1};
+    for (size_t count = 2; count <= nb_threads; count *= 2)
+        counts.push_back(count);
+    for (auto nb_workers: counts) {
+        bench_fork_join<Executor<>>("work-stealing", nb_workers);
+        bench_fork_join<LockedPool>("mutex+std::deque", nb_workers);
+        bench_fan_out<Executor<>>("work-stealing", nb_workers);
+        bench_fan_out<LockedPool>("mutex+std::deque", nb_workers);
+    }
+}
+static Bench::Register register_executor{"executor", bench_executors};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
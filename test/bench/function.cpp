@@ -0,0 +1,251 @@
+/**
+ * @file   function.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Function object holder benchmarks, against 'std::function'.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include <anyfunction.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Closures ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Standalone function.
+ * @param x
+ * @return x + 2
+**/
+static float standalone(float x) {
+    return x + 2;
+}
+
+/** Trivially copyable closure of the given size.
+ * @param size Closure size, in bytes
+**/
+template<size_t size> class Closure final {
+private:
+    float values[size / sizeof(float)]; // Captured state
+public:
+    Closure() noexcept {
+        for (auto&& value: values)
+            value = 1;
+    }
+    float operator()(float x) const noexcept {
+        return values[0] * x + values[size / sizeof(float) - 1];
+    }
+};
+
+/** Object with a member function to bind.
+**/
+class Scaler final {
+private:
+    float scale = 2; // Scale factor
+public:
+    float apply(float x) const noexcept {
+        return scale * x;
+    }
+};
+static Scaler const scaler;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Closures ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Function object holder construction helpers.
+ * @param functor Closure to store
+ * @return Function object holder
+**/
+template<class Holder> class Make final {
+public:
+    template<class Functor> Holder operator()(Functor const& functor) const {
+        return Holder{functor};
+    }
+};
+template<class Holder> class MakePooled final {
+public:
+    template<class Functor> Holder operator()(Functor const& functor) const {
+        return Holder{::std::allocator_arg, pool_resource(), functor};
+    }
+};
+
+/** Benchmark the basic operations of a function object holder.
+ * @param Holder  Function object holder class
+ * @param params  Closure name
+ * @param impl    Implementation name
+ * @param functor Closure to store
+ * @param make    Function object holder construction helper
+**/
+template<class Holder, class Functor, class Maker = Make<Holder>> static void bench_holder(char const* params, char const* impl, Functor const& functor, Maker make = Maker{}) {
+    Bench::measure("function", "construct", params, impl, [&]() {
+        auto func = make(functor);
+        Bench::keep(func);
+    });
+    { // Operations on an existing holder
+        auto func = make(functor);
+        Bench::measure("function", "copy", params, impl, [&]() {
+            Holder copy{func};
+            Bench::keep(copy);
+        });
+        Bench::measure("function", "assign", params, impl, [&]() {
+            func = functor;
+            Bench::keep(func);
+        });
+        Bench::measure("function", "call", params, impl, [&]() {
+            Bench::keep(func(3));
+        });
+    }
+    { // Back and forth moves
+        auto funcA = make(functor);
+        auto funcB = make(functor);
+        Bench::measure("function", "move", params, impl, [&]() {
+            funcB = ::std::move(funcA);
+            funcA = ::std::move(funcB);
+            Bench::keep(funcA);
+        }, 2);
+    }
+}
+
+/** Benchmark the basic operations of all the function object holders.
+ * @param params  Closure name
+ * @param functor Closure to store
+**/
+template<class Functor> static void bench_holders(char const* params, Functor const& functor) {
+    using Signature = float(float);
+    bench_holder<Function<Signature, 16>>(params, "anyfunction<16>", functor);
+    bench_holder<Function<Signature, 32>>(params, "anyfunction<32>", functor);
+    bench_holder<Function<Signature, 64>>(params, "anyfunction<64>", functor);
+    bench_holder<Function<Signature, 128>>(params, "anyfunction<128>", functor);
+    bench_holder<Function<Signature, 32>>(params, "anyfunction<32>+pool", functor, MakePooled<Function<Signature, 32>>{});
+    bench_holder<::std::function<Signature>>(params, "std::function", functor);
+}
+
+/** Benchmark moves between function object holders of different sizes.
+ * @param params  Closure name
+ * @param functor Closure to store
+**/
+template<class Functor> static void bench_mixed(char const* params, Functor const& functor) {
+    using Signature = float(float);
+    { // Small holder to large holder, and back
+        Function<Signature, 16> funcA = functor;
+        Function<Signature, 64> funcB;
+        Bench::measure("function", "mixed_move", params, "anyfunction<16><->anyfunction<64>", [&]() {
+            funcB = ::std::move(funcA);
+            funcA = ::std::move(funcB);
+            Bench::keep(funcA);
+        }, 2);
+    }
+    { // Same as above, for reference
+        ::std::function<Signature> funcA = functor;
+        ::std::function<Signature> funcB;
+        Bench::measure("function", "mixed_move", params, "std::function", [&]() {
+            funcB = ::std::move(funcA);
+            funcA = ::std::move(funcB);
+            Bench::keep(funcA);
+        }, 2);
+    }
+}
+
+/** Benchmark a container of function object holders.
+ * @param Holder  Function object holder class
+ * @param params  Closure name
+ * @param impl    Implementation name
+ * @param functor Closure to store
+**/
+template<class Holder, class Functor> static void bench_container(char const* params, char const* impl, Functor const& functor) {
+    constexpr static size_t count = 256;
+    Bench::measure("function", "vector_fill", params, impl, [&]() { // Includes the moves on vector growth
+        ::std::vector<Holder> funcs;
+        for (size_t i = 0; i < count; ++i)
+            funcs.emplace_back(functor);
+        Bench::keep(funcs);
+    }, count);
+    ::std::vector<Holder> funcs(count, Holder{functor});
+    Bench::measure("function", "vector_call", params, impl, [&]() {
+        float x = 0;
+        for (auto&& func: funcs)
+            x += func(x);
+        Bench::keep(x);
+    }, count);
+}
+
+/** Benchmark guarded devirtualization of the calls to a container of function object holders (see 'Function::invoke_as').
+ * @param Holder  Function object holder class
+ * @param params  Closure name
+ * @param impl    Implementation name
+ * @param functor Closure to store, the expected (hot) class
+**/
+template<class Holder, class Functor> static void bench_devirtualized(char const* params, char const* impl, Functor const& functor) {
+    constexpr static size_t count = 256;
+    ::std::vector<Holder> funcs(count, Holder{functor});
+    Bench::measure("function", "vector_invoke_as", params, impl, [&]() {
+        float x = 0;
+        for (auto&& func: funcs)
+            x += func.template invoke_as<Functor>(x);
+        Bench::keep(x);
+    }, count);
+}
+
+/** Benchmark containers of all the function object holders.
+ * @param params  Closure name
+ * @param functor Closure to store
+**/
+template<class Functor> static void bench_containers(char const* params, Functor const& functor) {
+    using Signature = float(float);
+    bench_container<Function<Signature, 32>>(params, "anyfunction<32>", functor);
+    bench_container<Function<Signature, 64>>(params, "anyfunction<64>", functor);
+    bench_devirtualized<Function<Signature, 32>>(params, "anyfunction<32>", functor);
+    bench_devirtualized<Function<Signature, 64>>(params, "anyfunction<64>", functor);
+    bench_container<::std::function<Signature>>(params, "std::function", functor);
+}
+
+/** Function object holder benchmark suite.
+**/
+static void bench_function() {
+    bench_holders("standalone", standalone);
+    bench_holders("closure8", Closure<8>{});
+    bench_holders("closure24", Closure<24>{});
+    bench_holders("closure56", Closure<56>{});
+    bench_holders("closure120", Closure<120>{});
+    bench_holders("delegate", Delegate<Scaler const, decltype(&Scaler::apply), &Scaler::apply>{scaler});
+    bench_holders("std::bind", ::std::bind(&Scaler::apply, &scaler, ::std::placeholders::_1));
+    bench_mixed("closure8", Closure<8>{});
+    bench_mixed("closure24", Closure<24>{});
+    bench_containers("closure8", Closure<8>{});
+    bench_containers("closure56", Closure<56>{});
+}
+static Bench::Register register_function{"function", bench_function};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Benchmarks ▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,135 @@
+/**
+ * @file   future.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Future/promise benchmarks, against continuations chained through 'std::shared_ptr' and 'std::function'.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// Internal headers
+#include <anyfunction_future.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Futures ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Shared state of a future chaining its continuation through 'std::function', for reference.
+ * @param Value Value class
+**/
+template<class Value> class NaiveState final {
+private:
+    ::std::mutex lock; // State lock
+    bool ready = false; // Whether the value is set
+    Value value{}; // Value, once set
+    ::std::function<void(Value)> next; // Continuation, if set before the value
+public:
+    void set(Value value) {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        this->value = value;
+        ready = true;
+        auto next = ::std::move(this->next);
+        guard.unlock();
+        if (next)
+            next(::std::move(value));
+    }
+    void chain(::std::function<void(Value)> next) {
+        ::std::unique_lock<::std::mutex> guard{lock};
+        if (!ready) {
+            this->next = ::std::move(next);
+            return;
+        }
+        guard.unlock();
+        next(value);
+    }
+};
+
+/** Future chaining its continuations through a new 'std::shared_ptr' state and a 'std::function' per step, for reference.
+ * @param Value Value class
+**/
+template<class Value> class NaiveFuture final {
+public:
+    ::std::shared_ptr<NaiveState<Value>> state; // Shared state
+public:
+    template<class Functor> auto then(Functor functor) -> NaiveFuture<decltype(functor(::std::declval<Value>()))> {
+        using Result = decltype(functor(::std::declval<Value>()));
+        NaiveFuture<Result> future{::std::make_shared<NaiveState<Result>>()};
+        state->chain([next = future.state, functor](Value value) { next->set(functor(::std::move(value))); });
+        return future;
+    }
+};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Futures ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Benchmark a pipeline of 4 continuations, chained before the value is set.
+**/
+static void bench_pipeline() {
+    size_t offset = 1; // Captured by the continuations
+    size_t scale = 3;
+    auto step = [offset, scale](size_t value) { return value * scale + offset; };
+    Bench::measure("future", "pipeline", "steps=4", "anyfunction", [&]() {
+        Promise<size_t> promise;
+        auto future = promise.get_future().then(step).then(step).then(step).then(step);
+        promise.set_value(1);
+        Bench::keep(future.get());
+    });
+    Bench::measure("future", "pipeline", "steps=4", "shared_ptr+std::function", [&]() {
+        NaiveFuture<size_t> first{::std::make_shared<NaiveState<size_t>>()};
+        size_t result = 0;
+        first.then(step).then(step).then(step).then(step).then([&result](size_t value) { result = value; return value; });
+        first.state->set(1);
+        Bench::keep(result);
+    });
+}
+
+/** Benchmark joining ready futures.
+**/
+static void bench_when_all() {
+    Bench::measure("future", "when_all", "futures=4", "anyfunction", [&]() {
+        auto all = when_all(make_ready_future(size_t{1}), make_ready_future(size_t{2}), make_ready_future(size_t{3}), make_ready_future(size_t{4}));
+        Bench::keep(all.get());
+    });
+}
+
+/** Future/promise benchmark suite.
+**/
+static void bench_future() {
+    bench_pipeline();
+    bench_when_all();
+}
+static Bench::Register register_future{"future", bench_future};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,154 @@
+/**
+ * @file   queue.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Function queue benchmarks, against a locked 'std::deque' of 'std::function'.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Internal headers
+#include <anyfunction_queue.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Queues ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Function queue adapter.
+ * @param Queue Function queue class
+**/
+template<class Queue> class Ring final {
+public:
+    using Holder = typename Queue::Holder;
+private:
+    Queue queue; // Adapted queue
+public:
+    Ring(size_t capacity): queue(capacity) {}
+    template<class Functor> bool push(Functor&& functor) {
+        return queue.try_push(::std::forward<Functor>(functor));
+    }
+    size_t pop(Holder* functions, size_t count) {
+        return queue.try_pop_batch(functions, count);
+    }
+};
+
+/** Locked 'std::deque' of 'std::function', for reference.
+**/
+class Locked final {
+public:
+    using Holder = ::std::function<void()>;
+private:
+    ::std::mutex lock; // Queue lock
+    ::std::deque<Holder> queue; // Locked queue
+public:
+    Locked(size_t) {}
+    template<class Functor> bool push(Functor&& functor) {
+        ::std::lock_guard<::std::mutex> guard{lock};
+        queue.emplace_back(::std::forward<Functor>(functor));
+        return true;
+    }
+    size_t pop(Holder* functions, size_t count) {
+        ::std::lock_guard<::std::mutex> guard{lock};
+        size_t popped = 0;
+        for (; popped < count && !queue.empty(); ++popped) {
+            functions[popped] = ::std::move(queue.front());
+            queue.pop_front();
+        }
+        return popped;
+    }
+};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Queues ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Benchmark the throughput of producers pushing tasks to one consumer (the calling thread), which runs them.
+ * @param Queue        Queue adapter class
+ * @param impl         Implementation name
+ * @param nb_producers Number of producer threads
+ * @param batch        Maximum number of tasks popped at once
+**/
+template<class Queue> static void bench_queue(char const* impl, size_t nb_producers, size_t batch) {
+    constexpr static size_t nb_tasks = 1 << 14; // Tasks pushed per measure, split between the producers
+    constexpr static size_t capacity = 1024;
+    auto params = "producers=" + ::std::to_string(nb_producers) + "/batch=" + ::std::to_string(batch);
+    Queue queue{capacity};
+    ::std::vector<typename Queue::Holder> functions(batch);
+    Bench::measure("queue", "push_pop_call", params.c_str(), impl, [&]() {
+        size_t sum = 0;
+        ::std::vector<::std::thread> producers;
+        for (size_t p = 0; p < nb_producers; ++p) {
+            producers.emplace_back([&, p]() {
+                for (size_t i = p; i < nb_tasks; i += nb_producers) {
+                    while (!queue.push([&sum, i]() { sum += i; })) // Only called by the consumer
+                        ::std::this_thread::yield();
+                }
+            });
+        }
+        for (size_t done = 0; done < nb_tasks;) {
+            auto popped = queue.pop(functions.data(), batch);
+            for (size_t i = 0; i < popped; ++i)
+                functions[i]();
+            done += popped;
+            if (popped == 0) // Let the producers run (if sharing a core)
+                ::std::this_thread::yield();
+        }
+        for (auto&& producer: producers)
+            producer.join();
+        Bench::keep(sum);
+    }, nb_tasks);
+}
+
+/** Function queue benchmark suite.
+**/
+static void bench_queues() {
+    auto nb_threads = static_cast<size_t>(::std::thread::hardware_concurrency());
+    ::std::vector<size_t> counts{1};
+    for (size_t count = 2; count < nb_threads; count *= 2) // One thread left for the consumer
+        counts.push_back(count);
+    for (auto nb_producers: counts) {
+        bench_queue<Ring<MpscFunctionQueue<void()>>>("mpsc", nb_producers, 1);
+        bench_queue<Ring<MpscFunctionQueue<void()>>>("mpsc", nb_producers, 32);
+        bench_queue<Ring<MpmcFunctionQueue<void()>>>("mpmc", nb_producers, 1);
+        bench_queue<Ring<MpmcFunctionQueue<void()>>>("mpmc", nb_producers, 32);
+        bench_queue<Locked>("mutex+std::deque", nb_producers, 1);
+        bench_queue<Locked>("mutex+std::deque", nb_producers, 32);
+    }
+}
+static Bench::Register register_queue{"queue", bench_queues};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
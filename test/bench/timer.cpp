@@ -0,0 +1,131 @@
+/**
+ * @file   timer.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Timing wheel benchmarks, with millions of pending timers, against an ordered 'std::multimap' of 'std::function'.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Internal headers
+#include <anyfunction_timer.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Timers ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Ordered map of timers, for reference.
+**/
+using TimerMap = ::std::multimap<uint64_t, ::std::function<void()>>;
+
+/** Number of pending timers in the benchmarks.
+**/
+static constexpr size_t nb_timers = 1 << 20;
+
+/** Pseudo-random delays, up to about 16M ticks.
+ * @return Delays, one per timer
+**/
+static ::std::vector<uint64_t> make_delays() {
+    ::std::vector<uint64_t> delays;
+    delays.reserve(nb_timers);
+    uint64_t seed = 1;
+    for (size_t i = 0; i < nb_timers; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        delays.push_back((seed >> 33) & ((uint64_t{1} << 24) - 1));
+    }
+    return delays;
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Timers ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Benchmark scheduling a million timers, then firing them all.
+**/
+static void bench_expire() {
+    auto delays = make_delays();
+    size_t fired = 0;
+    auto callback = [&fired]() { ++fired; };
+    TimingWheel<> wheel;
+    Bench::measure("timer", "schedule+expire", "timers=1M", "anyfunction", [&]() {
+        for (auto delay: delays)
+            wheel.schedule(delay, callback);
+        wheel.advance(wheel.now() + (uint64_t{1} << 24));
+    }, nb_timers);
+    uint64_t now = 0;
+    Bench::measure("timer", "schedule+expire", "timers=1M", "std::multimap", [&]() {
+        TimerMap timers;
+        for (auto delay: delays)
+            timers.emplace(now + delay, callback);
+        now += uint64_t{1} << 24;
+        while (!timers.empty() && timers.begin()->first <= now) {
+            auto func = ::std::move(timers.begin()->second);
+            timers.erase(timers.begin());
+            func();
+        }
+    }, nb_timers);
+    Bench::keep(fired);
+}
+
+/** Benchmark scheduling then cancelling a timer, with a million others pending.
+**/
+static void bench_cancel() {
+    auto delays = make_delays();
+    auto callback = []() {};
+    TimingWheel<> wheel;
+    for (auto delay: delays)
+        wheel.schedule(delay, callback);
+    size_t i = 0;
+    Bench::measure("timer", "schedule+cancel", "pending=1M", "anyfunction", [&]() {
+        wheel.cancel(wheel.schedule(delays[i++ % nb_timers], callback));
+    });
+    TimerMap timers;
+    for (auto delay: delays)
+        timers.emplace(delay, callback);
+    Bench::measure("timer", "schedule+cancel", "pending=1M", "std::multimap", [&]() {
+        timers.erase(timers.emplace(delays[i++ % nb_timers], callback));
+    });
+}
+
+/** Timing wheel benchmark suite.
+**/
+static void bench_timer() {
+    bench_expire();
+    bench_cancel();
+}
+static Bench::Register register_timer{"timer", bench_timer};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
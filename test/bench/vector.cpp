@@ -0,0 +1,145 @@
+/**
+ * @file   vector.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Function vector benchmarks, against 'std::vector' of function object holders.
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <functional>
+#include <string>
+#include <vector>
+
+// Internal headers
+#include <anyfunction_vector.hpp>
+#include "bench.hpp"
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Containers ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Trivially copyable closure of the given size, adding to its argument.
+ * @param size Closure size, in bytes
+**/
+template<size_t size> class Adder final {
+private:
+    float values[size / sizeof(float)]; // Captured state
+public:
+    Adder() noexcept {
+        for (auto&& value: values)
+            value = 1;
+    }
+    void operator()(float& x) const noexcept {
+        x += values[size / sizeof(float) - 1];
+    }
+};
+
+/** Function vector adapter.
+**/
+class Packed final {
+private:
+    FunctionVector<void(float&)> functions; // Adapted container
+public:
+    template<class Functor> void insert(Functor const& functor) {
+        functions.insert(functor);
+    }
+    void operator()(float& x) {
+        functions(x);
+    }
+};
+
+/** 'std::vector' of function object holders adapter.
+ * @param Holder Function object holder class
+**/
+template<class Holder> class Holders final {
+private:
+    ::std::vector<Holder> functions; // Adapted container
+public:
+    template<class Functor> void insert(Functor const& functor) {
+        functions.emplace_back(functor);
+    }
+    void operator()(float& x) {
+        for (auto&& function: functions)
+            function(x);
+    }
+};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Containers ▔
+// ▁ Benchmarks ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Fill a container with closures of cycling sizes (8, 24, 56 and 120 bytes).
+ * @param functions Container to fill
+ * @param count     Number of closures
+**/
+template<class Container> static void fill(Container& functions, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 4) {
+        case 0: functions.insert(Adder<8>{}); break;
+        case 1: functions.insert(Adder<24>{}); break;
+        case 2: functions.insert(Adder<56>{}); break;
+        default: functions.insert(Adder<120>{}); break;
+        }
+    }
+}
+
+/** Benchmark filling a container with mixed closures, then calling all of them.
+ * @param Container Container adapter class
+ * @param impl      Implementation name
+ * @param count     Number of closures
+**/
+template<class Container> static void bench_vector(char const* impl, size_t count) {
+    auto params = "subscribers=" + ::std::to_string(count);
+    Bench::measure("vector", "fill", params.c_str(), impl, [&]() { // Includes the moves on growth
+        Container functions;
+        fill(functions, count);
+        Bench::keep(functions);
+    }, count);
+    Container functions;
+    fill(functions, count);
+    Bench::measure("vector", "broadcast", params.c_str(), impl, [&]() {
+        float x = 0;
+        functions(x);
+        Bench::keep(x);
+    }, count);
+}
+
+/** Function vector benchmark suite.
+**/
+static void bench_vectors() {
+    for (size_t count: {256, 10000}) {
+        bench_vector<Packed>("function_vector", count);
+        bench_vector<Holders<Function<void(float&), 32>>>("vector<anyfunction<32>>", count);
+        bench_vector<Holders<Function<void(float&), 128>>>("vector<anyfunction<128>>", count);
+        bench_vector<Holders<::std::function<void(float&)>>>("vector<std::function>", count);
+    }
+}
+static Bench::Register register_vector{"vector", bench_vectors};
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
@@ -0,0 +1,173 @@
+/**
+ * @file   noexcept.cpp
+ * @author Sébastien Rouault <sebmsg@free.fr>
+ *
+ * @section LICENSE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * any later version. Please see https://gnu.org/licenses/gpl.html
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests of the builds without exception support, built once per empty call policy (see 'ANYFUNCTION_EMPTY_CALL').
+**/
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+// External headers
+#include <atomic>
+#include <csetjmp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Internal headers
+#include <anyfunction.hpp>
+#include <anyfunction_batch.hpp>
+#include <anyfunction_executor.hpp>
+#include <anyfunction_future.hpp>
+#include <anyfunction_queue.hpp>
+#include <anyfunction_timer.hpp>
+#include <anyfunction_vector.hpp>
+
+#ifndef ANYFUNCTION_NO_EXCEPTIONS
+#error "Build with '-fno-exceptions' or 'ANYFUNCTION_NO_EXCEPTIONS'"
+#endif
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+using namespace AnyFunction;
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Declarations ▔
+// ▁ Tests ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Function holders and containers, none of their error paths taken.
+**/
+static void test_holders() {
+    int a[8] = {1};
+    ::std::cout << "Function holders:" << ::std::endl;
+    {
+        Function<int(int)> funcA = [](int x) { return x + 2; };
+        Function<int(int)> funcB = [a](int x) { return a[0] * x + 2; }; // Heap-stored
+        UniqueFunction<int(int)> funcC = ::std::move(funcB);
+        SharedFunction<int(int)> funcD = funcA;
+        InplaceFunction<int(int), 16> funcE = funcA;
+        FunctionRef<int(int)> ref = funcA;
+        AtomicFunction<int(int)> funcF{[](int x) { return x + 2; }};
+        ::std::cout << "- [call] " << funcA(3) << ", " << funcC(3) << ", " << funcD(3) << ", " << funcE(3) << ", " << ref(3) << ", " << funcF(3) << ::std::endl;
+    }
+    {
+        size_t sum = 0;
+        FunctionVector<void(size_t)> functions;
+        auto first = functions.insert([&sum](size_t value) { sum += value; });
+        functions.insert([&sum, a](size_t value) { sum += value * a[0]; });
+        functions(2);
+        functions.erase(first);
+        functions.shrink_to_fit();
+        functions(3);
+        ::std::vector<Function<void(size_t&)>> funcs(3, [](size_t& value) { ++value; });
+        invoke_all(funcs, sum);
+        ::std::cout << "- [vector] sum: " << sum << ", size: " << functions.size() << ::std::endl;
+    }
+}
+
+/** Queues, executor, futures and timers.
+**/
+static void test_concurrency() {
+    ::std::cout << "Concurrency:" << ::std::endl;
+    {
+        MpscFunctionQueue<int()> queue{4};
+        queue.try_push([]() { return 1; });
+        queue.try_push([]() { return 2; });
+        MpscFunctionQueue<int()>::Holder functions[4];
+        auto popped = queue.try_pop_batch(functions, 4);
+        ::std::cout << "- [queue] popped: " << popped << ", sum: " << functions[0]() + functions[1]() << ::std::endl;
+    }
+    {
+        ::std::atomic<int> sum{0};
+        Executor<> executor{2};
+        for (int i = 0; i < 100; ++i)
+            executor.post([&sum, i]() { sum.fetch_add(i, ::std::memory_order_relaxed); });
+        executor.wait_idle();
+        ::std::cout << "- [executor] sum: " << sum.load() << ::std::endl;
+    }
+    {
+        Promise<int> promise;
+        auto all = when_all(promise.get_future().then([](int value) { return value * 2; }), make_ready_future());
+        promise.set_value(21);
+        ::std::cout << "- [future] value: " << ::std::get<0>(all.get()) << ::std::endl;
+    }
+    {
+        size_t fired = 0;
+        TimingWheel<> wheel;
+        wheel.schedule(10, [&fired]() { ++fired; });
+        wheel.schedule(1000, [&fired]() { ++fired; });
+        wheel.advance(2000);
+        ::std::cout << "- [timer] fired: " << fired << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+#if ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_HOOK
+static ::std::jmp_buf resume; // Where the empty call hook jumps back to, instead of returning (which aborts)
+#endif
+
+/** Empty holder calls, under the selected empty call policy.
+**/
+static void test_empty_call() {
+    Function<int(int)> empty;
+    Function<::std::string()> text;
+    ::std::cout << "Empty call:" << ::std::endl;
+#if ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_DEFAULT
+    ::std::cout << "- [default] values: " << empty(3) << ", \"" << text() << "\"" << ::std::endl;
+#elif ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_HOOK
+    static size_t hooked = 0;
+    set_empty_call_hook([]() {
+        ++hooked;
+        ::std::longjmp(resume, 1);
+    });
+    if (setjmp(resume) == 0)
+        empty(3);
+    if (setjmp(resume) == 0)
+        text();
+    set_empty_call_hook(nullptr);
+    ::std::cout << "- [hook] hook calls: " << hooked << ::std::endl;
+#elif ANYFUNCTION_EMPTY_CALL == ANYFUNCTION_EMPTY_CALL_ABORT
+    ::std::cout << "- [abort] not called (would abort), empty: " << !empty << ::std::endl;
+#else
+    ::std::cout << "- [unchecked] not called (undefined behavior), empty: " << !empty << ::std::endl;
+#endif
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Tests ▔
+// ▁ Entry point ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+
+/** Program entry point.
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return Return code
+**/
+int main(int argc, char** argv) {
+    test_holders();
+    test_concurrency();
+    test_empty_call();
+    return 0;
+}
+
+// ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
+// ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
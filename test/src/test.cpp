@@ -23,12 +23,30 @@
 // ▁ Declarations ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔
 
+// Compilation flags
+#define ANYFUNCTION_STATISTICS // Closure placement statistics (see 'test_statistics')
+
 // External headers
+#include <array>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 // Internal headers
 #include <anyfunction.hpp>
+#include <anyfunction_batch.hpp>
+#include <anyfunction_executor.hpp>
+#include <anyfunction_future.hpp>
+#include <anyfunction_queue.hpp>
+#include <anyfunction_timer.hpp>
+#include <anyfunction_vector.hpp>
 
 // ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
 
@@ -71,6 +89,11 @@ static void test_standalone() {
         } else {
             ::std::cout << "- source not valid anymore" << ::std::endl;
         }
+        try {
+            funcA(3);
+        } catch (Exception::Empty const& err) {
+            ::std::cout << "- call on invalid source: " << err.what() << ::std::endl;
+        }
     }
 }
 
@@ -293,6 +316,1120 @@ static void test_functor() {
     }
 }
 
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Move-only functor manipulation.
+**/
+static void test_unique() {
+    static_assert(!::std::is_copy_constructible<UniqueFunction<float(float)>>::value, "'UniqueFunction' must not be copyable");
+    static_assert(::std::is_constructible<UniqueFunction<float(float)>, Function<float(float), 64> const&>::value, "'UniqueFunction' must be copyable from 'Function'");
+    static_assert(!::std::is_constructible<Function<float(float)>, UniqueFunction<float(float), 64>&&>::value, "'Function' must not be movable from 'UniqueFunction'");
+    auto lambda = [a = ::std::unique_ptr<float>(new float(1)), b = 2.f](float x) -> float {
+        return *a * x + b;
+    };
+    ::std::cout << "Move-only functor:" << ::std::endl;
+    { // Move from local to local
+        UniqueFunction<float(float), 64> funcA = ::std::move(lambda);
+        auto r = funcA(3);
+        UniqueFunction<float(float), 64> funcB = ::std::move(funcA);
+        ::std::cout << "- [move] local -> local: " << r << ", " << funcB(3) << ::std::endl;
+        { // Move from local to remote
+            UniqueFunction<float(float), 0> funcC = ::std::move(funcB);
+            ::std::cout << "- [move] local -> remote: " << r << ", " << funcC(3) << ::std::endl;
+            { // Move from remote to local
+                funcB = ::std::move(funcC);
+                ::std::cout << "- [move] remote -> local: " << r << ", " << funcB(3) << ::std::endl;
+            }
+        }
+    }
+    { // Copy and move from copyable holder
+        Function<float(float), 64> funcA = [](float x) -> float { return x + 2; };
+        UniqueFunction<float(float), 0> funcB = funcA;
+        UniqueFunction<float(float), 64> funcC = ::std::move(funcA);
+        ::std::cout << "- [copy/move] copyable -> move-only: " << funcB(3) << ", " << funcC(3) << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Trivially relocatable test functor.
+**/
+class Relocated final {
+private:
+    float a;
+    float b;
+public:
+    /** Value constructor.
+    **/
+    Relocated(float a, float b): a(a), b(b) {}
+    /** Copy/move constructor.
+     * @param test Instance to copy/move
+    **/
+    Relocated(Relocated const& test): a(test.a), b(test.b) {
+        ::std::cout << "  - trace: copy constructing " << this << " with " << ::std::addressof(test) << ::std::endl;
+    }
+    Relocated(Relocated&& test): a(test.a), b(test.b) {
+        ::std::cout << "  - trace: move constructing " << this << " with " << ::std::addressof(test) << ::std::endl;
+    }
+    /** Computes y = a * x + b.
+     * @param x
+     * @return y
+    **/
+    float operator()(float x) const {
+        return a * x + b;
+    }
+};
+namespace AnyFunction {
+    template<> class is_trivially_relocatable<Relocated>: public ::std::true_type {};
+}
+
+/** Trivially relocatable functor manipulation.
+**/
+static void test_relocatable() {
+    static_assert(::std::is_nothrow_move_constructible<Function<float(float)>>::value, "'Function' move constructor must not throw");
+    ::std::cout << "Relocatable functor:" << ::std::endl;
+    { // Move from local to local
+        Function<float(float), 64> funcA = Relocated(1, 2);
+        auto r = funcA(3);
+        Function<float(float), 64> funcB = ::std::move(funcA);
+        Function<float(float), 128> funcC = ::std::move(funcB);
+        ::std::cout << "- [move] local -> local: " << r << ", " << funcC(3) << ::std::endl;
+    }
+    { // Swap
+        Function<float(float)> funcA = Relocated(1, 2);
+        Function<float(float)> funcB = relocatable([](float x) -> float { return x - 2; });
+        swap(funcA, funcB);
+        ::std::cout << "- [swap] local <-> local: " << funcA(3) << ", " << funcB(3) << ::std::endl;
+    }
+    { // Container growth
+        ::std::vector<Function<float(float)>> funcs;
+        for (auto i = 0; i < 4; ++i)
+            funcs.emplace_back(Relocated(1, i));
+        ::std::cout << "- [grow] local -> local:";
+        for (auto&& func: funcs)
+            ::std::cout << " " << func(3);
+        ::std::cout << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Memory resource manipulation.
+**/
+static void test_resource() {
+    /** Tracing memory resource.
+    **/
+    class Tracer final: public MemoryResource {
+    protected:
+        void* do_allocate(size_t size, size_t align) {
+            auto ptr = ::operator new(size);
+            ::std::cout << "  - trace: allocating " << size << " bytes at " << ptr << ::std::endl;
+            return ptr;
+        }
+        void do_deallocate(void* ptr, size_t size, size_t align) noexcept {
+            ::std::cout << "  - trace: deallocating " << size << " bytes at " << ptr << ::std::endl;
+            ::operator delete(ptr);
+        }
+    };
+    Tracer tracerA;
+    Tracer tracerB;
+    float a = 1;
+    float b = 2;
+    float c = 0;
+    auto lambda = [a, b, c](float x) -> float { // Larger than a pointer, so heap-stored in holders without local storage
+        return a * x + b + c;
+    };
+    ::std::cout << "Memory resource:" << ::std::endl;
+    { // Copy from local to remote
+        Function<float(float), 64> funcA = lambda;
+        Function<float(float), 0> funcB{::std::allocator_arg, &tracerA, funcA};
+        ::std::cout << "- [copy] local -> remote: " << funcA(3) << ", " << funcB(3) << ::std::endl;
+    }
+    { // Copy from remote to remote
+        Function<float(float), 0> funcA{::std::allocator_arg, &tracerA, lambda};
+        Function<float(float), 0> funcB = funcA;
+        ::std::cout << "- [copy] remote -> remote: " << funcA(3) << ", " << funcB(3) << ::std::endl;
+    }
+    { // Move from remote to remote, same resource
+        Function<float(float), 0> funcA{::std::allocator_arg, &tracerA, lambda};
+        auto r = funcA(3);
+        Function<float(float), 0> funcB{::std::allocator_arg, &tracerA};
+        funcB = ::std::move(funcA);
+        ::std::cout << "- [move] remote -> remote (same resource): " << r << ", " << funcB(3) << ::std::endl;
+    }
+    { // Move from remote to remote, other resource
+        Function<float(float), 0> funcA{::std::allocator_arg, &tracerA, lambda};
+        auto r = funcA(3);
+        Function<float(float), 0> funcB{::std::allocator_arg, &tracerB};
+        funcB = ::std::move(funcA);
+        ::std::cout << "- [move] remote -> remote (other resource): " << r << ", " << funcB(3) << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Pool memory resource manipulation.
+**/
+static void test_pool() {
+    float a[16] = {1};
+    float b = 2;
+    auto lambda = [a, b](float x) -> float {
+        return a[0] * x + b;
+    };
+    auto print = [](char const* text) {
+        auto stats = PoolResource::statistics();
+        ::std::cout << "- " << text << ": " << stats.hits << " hit(s), " << stats.misses << " miss(es), " << stats.remote_frees << " remote free(s), hit rate " << stats.hit_rate() << ::std::endl;
+    };
+    ::std::cout << "Pool memory resource:" << ::std::endl;
+    PoolResource::reset_statistics();
+    { // Allocate then free on the same thread
+        for (auto i = 0; i < 4; ++i) {
+            Function<float(float)> func{::std::allocator_arg, pool_resource(), lambda};
+            func(3);
+        }
+        print("same thread");
+    }
+    { // Allocate on another thread, then free on this thread
+        Function<float(float)> func{::std::allocator_arg, pool_resource()};
+        ::std::thread([&]() {
+            func = lambda;
+        }).join(); // Other thread exited before the free
+        func = nullptr;
+        print("freed after owner exit");
+    }
+    { // Allocate on this thread, then free on another thread
+        Function<float(float)> func{::std::allocator_arg, pool_resource(), lambda};
+        ::std::thread([&]() {
+            func = nullptr;
+        }).join();
+        func = lambda; // Takes back the block freed by the other thread
+        print("freed by other thread");
+    }
+    { // Over-aligned blocks (as for over-aligned closures), not served by the pool
+        bool aligned = true;
+        for (size_t align = 32; align <= 4096; align *= 2) {
+            for (size_t size: {size_t{8}, size_t{100}, size_t{1000}}) {
+                auto ptr = pool_resource()->allocate(size, align);
+                aligned = aligned && reinterpret_cast<uintptr_t>(ptr) % align == 0;
+                ::std::memset(ptr, 0, size);
+                pool_resource()->deallocate(ptr, size, align);
+            }
+        }
+        ::std::cout << "- over-aligned blocks: all aligned: " << aligned << ", fallbacks: " << PoolResource::statistics().fallbacks << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Holder layout manipulation.
+**/
+static void test_layout() {
+    using Small = Function<void(), 0>;
+    using Line = Function<void(), 64 - 3 * sizeof(void*), DefaultPolicy, 64>;
+    static_assert(Small::capacity >= sizeof(void*), "Holders must at least store a pointer locally");
+    static_assert(sizeof(Line) == 64 && alignof(Line) == 64, "Holder must fit exactly one cache line");
+    ::std::cout << "Holder layout:" << ::std::endl;
+    ::std::cout << "- Function<void(), 0>: " << sizeof(Small) << " bytes, " << Small::capacity << " bytes locally" << ::std::endl;
+    ::std::cout << "- Function<void(), 32>: " << sizeof(Function<void()>) << " bytes, " << Function<void()>::capacity << " bytes locally" << ::std::endl;
+    ::std::cout << "- Function<void(), " << 64 - 3 * sizeof(void*) << ", DefaultPolicy, 64>: " << sizeof(Line) << " bytes, " << Line::capacity << " bytes locally" << ::std::endl;
+    { // Holder array, each holder in its own cache line
+        Line lines[4]; // Over-aligned, so not in a 'vector' before C++17
+        float a[4] = {1, 2, 3, 4};
+        for (auto i = 0; i < 4; ++i)
+            lines[i] = [a, i]() { ::std::cout << " " << a[i]; }; // Fits locally
+        ::std::cout << "- [call] line array:";
+        for (auto&& line: lines)
+            line();
+        ::std::cout << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function reference manipulation.
+**/
+static void test_ref() {
+    static_assert(sizeof(FunctionRef<float(float)>) == 2 * sizeof(void*), "Function reference must be two pointers");
+    auto visit = [](char const* text, FunctionRef<float(float)> func) { // Callback parameter
+        ::std::cout << "- [call] " << text << ": " << func(3) << ::std::endl;
+    };
+    float a = 1;
+    float b = 2;
+    auto lambda = [&](float x) -> float {
+        return a * x + b;
+    };
+    auto const constant = [](float x) -> float {
+        return x + 2;
+    };
+    ::std::cout << "Function reference:" << ::std::endl;
+    visit("lambda", lambda);
+    visit("const lambda", constant);
+    visit("temporary lambda", [](float x) -> float { return x + 2; });
+    visit("standalone", standalone);
+    { // Function holders, whatever their storage size
+        Function<float(float), 64> funcA = lambda;
+        Function<float(float), 0> funcB = lambda;
+        visit("local holder", funcA);
+        visit("remote holder", funcB);
+    }
+    { // Empty references
+        Function<float(float)> func;
+        FunctionRef<float(float)> ref = func;
+        if (!ref) {
+            ::std::cout << "- empty holder reference not valid" << ::std::endl;
+        }
+        try {
+            ref(3);
+        } catch (Exception::Empty const& err) {
+            ::std::cout << "- call on empty reference: " << err.what() << ::std::endl;
+        }
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Shared function holder manipulation.
+**/
+static void test_shared() {
+    /** Counting memory resource.
+    **/
+    class Counter final: public MemoryResource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+    protected:
+        void* do_allocate(size_t size, size_t align) {
+            ++allocations;
+            return ::operator new(size);
+        }
+        void do_deallocate(void* ptr, size_t size, size_t align) noexcept {
+            ++deallocations;
+            ::operator delete(ptr);
+        }
+        bool do_is_equal(MemoryResource const& other) const noexcept {
+            return this == &other;
+        }
+    };
+    Counter counter;
+    float a[16] = {1};
+    float b = 2;
+    auto lambda = [a, b](float x) -> float { // Too large for the local storage
+        return a[0] * x + b;
+    };
+    ::std::cout << "Shared function holder:" << ::std::endl;
+    { // Fan out a large closure
+        SharedFunction<float(float)> func{::std::allocator_arg, &counter, lambda};
+        ::std::vector<SharedFunction<float(float)>> copies(4, func);
+        Function<float(float)> plain = func; // Copyable holders share too
+        ::std::cout << "- [copy] fan out to " << copies.size() + 1 << " holders: " << copies[3](3) << ", " << plain(3) << ", " << counter.allocations << " allocation(s)" << ::std::endl;
+        copies.clear();
+        ::std::cout << "- [clear] copies: " << func(3) << ", " << counter.deallocations << " deallocation(s)" << ::std::endl;
+    }
+    ::std::cout << "- [clear] all holders: " << counter.deallocations << " deallocation(s)" << ::std::endl;
+    { // Non-atomic reference count, and copy to another memory resource
+        Function<float(float), 32, SharedNonAtomicPolicy> funcA{::std::allocator_arg, &counter, lambda};
+        Function<float(float), 32, SharedNonAtomicPolicy> funcB{::std::allocator_arg, nullptr, funcA}; // Deep copy
+        Function<float(float), 32, SharedNonAtomicPolicy> funcC = funcA;
+        ::std::cout << "- [copy] non-atomic: " << funcA(3) << ", " << funcB(3) << ", " << funcC(3) << ", " << counter.allocations << " allocation(s)" << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** In-place construction manipulation.
+**/
+static void test_emplace() {
+    /** Functor counting its constructions and copies/moves.
+    **/
+    class Heavy final {
+    private:
+        size_t* counts; // Constructions, then copies/moves
+        float values[32];
+    public:
+        Heavy(size_t* counts, float a, float b): counts(counts) {
+            values[0] = a;
+            values[1] = b;
+            ++counts[0];
+        }
+        Heavy(Heavy const& other): counts(other.counts) {
+            ::std::memcpy(values, other.values, sizeof(values));
+            ++counts[1];
+        }
+        Heavy(Heavy&& other) noexcept: Heavy(static_cast<Heavy const&>(other)) {}
+        float operator()(float x) const {
+            return values[0] * x + values[1];
+        }
+    };
+    size_t counts[2] = {0, 0};
+    auto print = [&](char const* text, float a, float b) {
+        ::std::cout << "- " << text << ": " << a << ", " << b << ", " << counts[0] << " construction(s), " << counts[1] << " copy/move(s)" << ::std::endl;
+    };
+    ::std::cout << "In-place construction:" << ::std::endl;
+    { // Emplace, local and remote
+        Function<float(float), sizeof(Heavy)> funcA;
+        Function<float(float)> funcB;
+        funcA.emplace<Heavy>(counts, 1, 2);
+        funcB.emplace<Heavy>(counts, 1, 2);
+        print("[emplace] local, remote", funcA(3), funcB(3));
+    }
+    { // Constructor, with memory resource
+        Function<float(float)> funcA{in_place_type<Heavy>, counts, 1, 2};
+        Function<float(float)> funcB{::std::allocator_arg, pool_resource(), in_place_type<Heavy>, counts, 1, 2};
+        print("[in_place_type] remote, remote with resource", funcA(3), funcB(3));
+    }
+    { // Factory function
+        auto funcA = make_function<float(float), sizeof(Heavy), Heavy>(counts, 1, 2);
+        auto funcB = make_function<float(float), Heavy>(counts, 1, 2);
+        print("[make_function] local, remote", funcA(3), funcB(3));
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Closure placement statistics manipulation.
+**/
+static void test_statistics() {
+    /** Functor whose move constructor could throw.
+    **/
+    class Throwing final {
+    public:
+        Throwing() = default;
+        Throwing(Throwing const&) = default;
+        Throwing(Throwing&&) {}
+        int operator()(int x) const {
+            return x + 2;
+        }
+    };
+    using Holder = Function<int(int), 24>;
+    int a[8] = {1};
+    auto small = [](int x) { return x + 2; };
+    auto large = [a](int x) { return a[0] * x + 2; };
+    ::std::cout << "Closure placement statistics:" << ::std::endl;
+    Holder::statistics().reset();
+    {
+        Holder funcA = small;
+        Holder funcB = large;
+        Holder funcC = Throwing{};
+        Holder funcD = funcA; // Copy
+        Function<int(int), 64> funcE = funcB; // Copy, to another holder class
+        Holder funcF = ::std::move(funcE); // Move, back to this holder class
+    }
+    auto&& stats = Holder::statistics();
+    auto print = [](char const* text, Statistics::Counter const* counters, size_t count) {
+        ::std::cout << "- " << text << ":";
+        for (size_t i = 0; i < count; ++i)
+            ::std::cout << " " << counters[i];
+        ::std::cout << ::std::endl;
+    };
+    ::std::cout << "- constructions, copies, moves: " << stats.constructions << ", " << stats.copies << ", " << stats.moves << ::std::endl;
+    ::std::cout << "- local, remote: " << stats.local << ", " << stats.remote << ::std::endl;
+    ::std::cout << "- too large, too aligned, throwing move: " << stats.too_large << ", " << stats.too_aligned << ", " << stats.throwing_move << ::std::endl;
+    ::std::cout << "- heap allocations, bytes: " << stats.heap_allocations << ", " << stats.heap_bytes << ::std::endl;
+    print("size histogram", stats.sizes, Statistics::nb_size_buckets);
+    print("alignment histogram", stats.aligns, Statistics::nb_align_buckets);
+    size_t count = 0;
+    Statistics::for_each([&](Statistics&) { ++count; });
+    ::std::cout << "- registered holder classes: " << count << ::std::endl;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Heap-free function holder manipulation.
+**/
+static void test_inplace() {
+    int a[8] = {1};
+    auto small = [](int x) { return x + 2; };
+    auto large = [a](int x) { return a[0] * x + 2; };
+    static_assert(fits_inline<decltype(small), 8>::value, "Small closure must fit in 8 bytes");
+    static_assert(!fits_inline<decltype(large), 16>::value && fits_inline<decltype(large), 32>::value, "Large closure must fit in 32 bytes only");
+    using Small = InplaceFunction<int(int), 16>;
+    using Large = InplaceFunction<int(int), 32>;
+    ::std::cout << "Heap-free function holder:" << ::std::endl;
+    { // Construction, copy and conversions that fit
+        Small funcA = small;
+        Large funcB = large;
+        Large funcC = funcA; // Always fits
+        Small funcD = Function<int(int), 64>{small}; // Fits at runtime
+        ::std::cout << "- [copy] fitting closures: " << funcA(3) << ", " << funcB(3) << ", " << funcC(3) << ", " << funcD(3) << ::std::endl;
+    }
+    { // Conversion that does not fit
+        Large funcA = large;
+        try {
+            Small funcB = funcA;
+            ::std::cout << "- [copy] overflowing closure: " << funcB(3) << ::std::endl;
+        } catch (Exception::Overflow const& err) {
+            ::std::cout << "- [copy] overflowing closure: " << err.what() << ", source still valid: " << funcA(3) << ::std::endl;
+        }
+    }
+    { // Moves of heap-stored closures: never taken over, moved to the local storage if they fit
+        Function<int(int), 8> funcA = large;
+        try {
+            Small funcB = ::std::move(funcA);
+            ::std::cout << "- [move] overflowing heap-stored closure: " << funcB(3) << ::std::endl;
+        } catch (Exception::Overflow const& err) {
+            ::std::cout << "- [move] overflowing heap-stored closure: " << err.what() << ", source still valid: " << funcA(3) << ::std::endl;
+        }
+        Large funcC = ::std::move(funcA);
+        ::std::cout << "- [move] fitting heap-stored closure: " << funcC(3) << ", source emptied: " << !funcA << ::std::endl;
+    }
+#ifdef ANYFUNCTION_STATISTICS
+    ::std::cout << "- heap allocations: " << Small::statistics().heap_allocations + Large::statistics().heap_allocations << ::std::endl;
+#endif
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Call argument forwarding manipulation.
+**/
+static void test_forward() {
+    /** Argument counting its copies/moves.
+    **/
+    class Tracked final {
+    private:
+        size_t* counts; // Copies, then moves
+    public:
+        Tracked(size_t* counts): counts(counts) {}
+        Tracked(Tracked const& other): counts(other.counts) {
+            ++counts[0];
+        }
+        Tracked(Tracked&& other): counts(other.counts) {
+            ++counts[1];
+        }
+    };
+    size_t counts[2] = {0, 0};
+    auto print = [&](char const* text) {
+        ::std::cout << "- [call] " << text << ": " << counts[0] << " copy(ies), " << counts[1] << " move(s)" << ::std::endl;
+        counts[0] = 0;
+        counts[1] = 0;
+    };
+    static_assert(::std::is_same<forward_t<int>, int>::value && ::std::is_same<forward_t<Tracked>, Tracked&&>::value && ::std::is_same<forward_t<Tracked const&>, Tracked const&>::value, "Unexpected invoker parameter types");
+    ::std::cout << "Call argument forwarding:" << ::std::endl;
+    Function<void(Tracked)> byValue = [](Tracked) {};
+    Function<void(Tracked const&)> byReference = [](Tracked const&) {};
+    Tracked tracked{counts};
+    byValue(tracked);
+    print("by value, from l-value");
+    byValue(Tracked{counts});
+    print("by value, from r-value");
+    byReference(tracked);
+    print("by reference");
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Multi-signature function holder manipulation.
+**/
+static void test_overloads() {
+    /** Visitor with several call operators.
+    **/
+    class Visitor final {
+    private:
+        char const* name; // Visitor name
+        char padding[48]; // Makes the visitor heap-stored in default holders
+    public:
+        Visitor(char const* name): name(name) {}
+        ::std::string operator()(int x) const {
+            return ::std::string{name} + " int " + ::std::to_string(x);
+        }
+        ::std::string operator()(double x) const {
+            return ::std::string{name} + " double " + ::std::to_string(x);
+        }
+        ::std::string operator()(char const* x) const {
+            return ::std::string{name} + " string " + x;
+        }
+    };
+    using Holder = Function<Overloads<::std::string(int), ::std::string(double), ::std::string(char const*)>>;
+    static_assert(sizeof(Holder) == sizeof(Function<::std::string(int)>), "Multi-signature holders must be as large as single-signature ones");
+    ::std::cout << "Multi-signature function holder:" << ::std::endl;
+    auto lambda = [](auto x) { return ::std::string{"generic "} + ::std::to_string(sizeof(x)); };
+    Holder funcA = lambda; // Locally-stored
+    Holder funcB{in_place_type<Visitor>, "visitor"}; // Heap-stored
+    ::std::cout << "- [call] local: " << funcA(1) << ", " << funcA(2.) << ", " << funcA("3") << ::std::endl;
+    ::std::cout << "- [call] remote: " << funcB(1) << ", " << funcB(2.) << ", " << funcB("3") << ::std::endl;
+    Function<Overloads<::std::string(int), ::std::string(double), ::std::string(char const*)>, 64> funcC = funcB; // Copy, now locally-stored
+    Holder funcD = ::std::move(funcA);
+    ::std::cout << "- [copy/move] " << funcC(4.) << ", " << funcD("5") << ", source " << (funcA ? "valid" : "invalid") << ::std::endl;
+    Function<Overloads<::std::string(int), ::std::string(double), ::std::string(char const*)>, 32, SharedPolicy> funcE = Visitor{"shared"};
+    auto funcF = funcE; // Shared instance
+    ::std::cout << "- [shared] " << funcF(6) << ::std::endl;
+    try {
+        funcA("7");
+    } catch (Exception::Empty const& err) {
+        ::std::cout << "- [call] empty: " << err.what() << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Held functor access manipulation.
+**/
+static void test_target() {
+    /** Hot functor class, known by the caller.
+    **/
+    class Hot final {
+    public:
+        int offset;
+        int padding[3]; // Makes the functor heap-stored in 8-byte holders
+        int operator()(int x) const {
+            return x + offset;
+        }
+    };
+    ::std::cout << "Held functor access:" << ::std::endl;
+    Function<int(int)> funcA = Hot{1};
+    Function<int(int)> funcB = [](int x) { return x * 2; };
+    Function<int(int), 8> funcC = Hot{3}; // Heap-stored
+    SharedFunction<int(int), 8> funcD = Hot{4}; // Shared (too large), so only accessible as const
+    Function<float(float)> funcE = standalone;
+    Function<Overloads<int(int), int(double)>> funcF = Hot{5}; // Multi-signature
+    ::std::cout << "- [type] " << (funcA.target_type() == type_id<Hot>()) << (funcB.target_type() == type_id<Hot>()) << (funcD.target_type() == type_id<Hot>()) << (Function<int(int)>{}.target_type() ? 1 : 0) << ::std::endl;
+    ::std::cout << "- [target] " << (funcA.target<Hot>() ? funcA.target<Hot>()->offset : -1) << ", " << (funcB.target<Hot>() ? funcB.target<Hot>()->offset : -1) << ", " << (funcC.target<Hot>() ? funcC.target<Hot>()->offset : -1) << ", " << (funcD.target<Hot>() ? 1 : 0) << (static_cast<decltype(funcD) const&>(funcD).target<Hot>() ? 1 : 0) << ", " << (*funcE.target<float (*)(float)>() == standalone) << ", " << funcF.target<Hot>()->offset << ::std::endl;
+    funcA.target<Hot>()->offset = 2;
+    ::std::cout << "- [invoke as] " << funcA.invoke_as<Hot>(1) << ", " << funcB.invoke_as<Hot>(1) << ", " << funcC.invoke_as<Hot>(1) << ", " << funcD.invoke_as<Hot>(1) << ::std::endl;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Atomic function holder manipulation.
+**/
+static void test_atomic() {
+    /** Versioned handler, counting its live instances.
+    **/
+    class Handler final {
+    private:
+        int version; // Handler version
+        ::std::atomic<int>* alive; // Live instances
+    public:
+        Handler(int version, ::std::atomic<int>* alive): version(version), alive(alive) {
+            ++*alive;
+        }
+        Handler(Handler const& other): version(other.version), alive(other.alive) {
+            ++*alive;
+        }
+        ~Handler() {
+            --*alive;
+        }
+        int operator()(int x) const {
+            return version * 1000 + x;
+        }
+    };
+    ::std::cout << "Atomic function holder:" << ::std::endl;
+    ::std::atomic<int> alive{0};
+    { // Stress: readers call while a writer keeps replacing the handler
+        constexpr static size_t nb_readers = 4;
+        constexpr static int nb_stores = 1000;
+        AtomicFunction<int(int)> handler{Handler{0, &alive}};
+        ::std::atomic<bool> stop{false};
+        ::std::atomic<size_t> invalid{0};
+        ::std::vector<::std::thread> readers;
+        for (size_t i = 0; i < nb_readers; ++i) {
+            readers.emplace_back([&]() {
+                while (!stop.load(::std::memory_order_relaxed)) {
+                    auto result = handler(7);
+                    if (result % 1000 != 7 || result / 1000 > nb_stores)
+                        invalid.fetch_add(1, ::std::memory_order_relaxed);
+                }
+            });
+        }
+        for (int version = 1; version <= nb_stores; ++version)
+            handler.store(Handler{version, &alive});
+        stop.store(true, ::std::memory_order_relaxed);
+        for (auto&& reader: readers)
+            reader.join();
+        ::std::cout << "- [stress] " << nb_stores << " stores, invalid calls: " << invalid << ", live handlers: " << alive << ", last call: " << handler(7) << ::std::endl;
+    }
+    { // Readers do not block, even while a writer waits for a slow call to return
+        ::std::atomic<bool> entered{false};
+        ::std::atomic<bool> release{false};
+        AtomicFunction<int(int)> handler{[&](int x) {
+            if (x < 0) { // Slow call
+                entered.store(true);
+                while (!release.load())
+                    ::std::this_thread::yield();
+            }
+            return x;
+        }};
+        ::std::thread slow{[&]() { handler(-1); }};
+        while (!entered.load())
+            ::std::this_thread::yield();
+        ::std::atomic<bool> stored{false};
+        ::std::thread writer{[&]() {
+            handler.store([](int x) { return x + 1; });
+            stored.store(true);
+        }};
+        size_t calls = 0;
+        while (handler(1) != 2) // Wait for the new handler to be published
+            ::std::this_thread::yield();
+        for (; calls < 1000; ++calls) // Calls while the writer is still waiting
+            handler(1);
+        auto waiting = !stored.load();
+        release.store(true);
+        slow.join();
+        writer.join();
+        ::std::cout << "- [progress] calls during the grace period: " << calls << ", writer was waiting: " << (waiting ? "yes" : "no") << ::std::endl;
+    }
+    {
+        AtomicFunction<int(int)> handler;
+        auto previous = handler.exchange(Handler{1, &alive});
+        ::std::cout << "- [exchange] previous: " << (previous ? "valid" : "invalid") << ", current: " << handler(2) << ", copy: " << handler.load()(3) << ::std::endl;
+    }
+    ::std::cout << "- live handlers: " << alive << ::std::endl;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function queue manipulation.
+**/
+static void test_queue() {
+    constexpr static size_t nb_producers = 4;
+    constexpr static size_t nb_tasks = 10000; // Per producer
+    ::std::cout << "Function queue:" << ::std::endl;
+    { // Bounds and push order
+        MpscFunctionQueue<int()> queue{3};
+        size_t pushed = 0;
+        while (queue.try_push([pushed]() { return static_cast<int>(pushed); }))
+            ++pushed;
+        ::std::cout << "- [bounds] capacity: " << queue.capacity() << ", pushed: " << pushed << ", popped:";
+        MpscFunctionQueue<int()>::Holder functions[8];
+        auto popped = queue.try_pop_batch(functions, 8);
+        for (size_t i = 0; i < popped; ++i)
+            ::std::cout << " " << functions[i]();
+        ::std::cout << ", then empty: " << !queue.try_pop(functions[0]) << ::std::endl;
+    }
+    { // Popping to a holder whose memory resource fails, the claimed slots must be freed
+        class Failing final: public MemoryResource {
+        protected:
+            void* do_allocate(size_t, size_t) {
+                throw ::std::bad_alloc{};
+            }
+            void do_deallocate(void* ptr, size_t, size_t) noexcept {
+                ::operator delete(ptr);
+            }
+        };
+        Failing failing;
+        MpmcFunctionQueue<int()> queue{4};
+        ::std::array<size_t, 16> large{{7}}; // Heap-stored closure
+        queue.try_push([large]() { return static_cast<int>(large[0]); });
+        queue.try_push([large]() { return static_cast<int>(large[0]); });
+        MpmcFunctionQueue<int()>::Holder functions[2] = {MpmcFunctionQueue<int()>::Holder{::std::allocator_arg, &failing}, MpmcFunctionQueue<int()>::Holder{::std::allocator_arg, &failing}};
+        try {
+            queue.try_pop_batch(functions, 2);
+        } catch (::std::bad_alloc const&) {
+            ::std::cout << "- [unwind] pop failed, ";
+        }
+        size_t pushed = 0;
+        while (queue.try_push([]() { return 1; }))
+            ++pushed;
+        MpmcFunctionQueue<int()>::Holder function;
+        size_t popped = 0;
+        while (queue.try_pop(function))
+            popped += function();
+        ::std::cout << "then pushed: " << pushed << ", popped: " << popped << ::std::endl;
+    }
+    auto run = [&](auto& queue, size_t nb_consumers) { // Concurrent producers/consumers, return the sum of the task results
+        ::std::atomic<size_t> sum{0};
+        ::std::atomic<size_t> done{0};
+        ::std::vector<::std::thread> threads;
+        for (size_t p = 0; p < nb_producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for (size_t i = 0; i < nb_tasks; ++i) {
+                    auto value = p * nb_tasks + i;
+                    while (!queue.try_push([&sum, value]() { sum.fetch_add(value, ::std::memory_order_relaxed); }))
+                        ::std::this_thread::yield();
+                }
+            });
+        }
+        for (size_t c = 0; c < nb_consumers; ++c) {
+            threads.emplace_back([&]() {
+                typename ::std::remove_reference<decltype(queue)>::type::Holder functions[16];
+                while (done.load() < nb_producers * nb_tasks) {
+                    auto popped = queue.try_pop_batch(functions, 16);
+                    for (size_t i = 0; i < popped; ++i)
+                        functions[i]();
+                    done.fetch_add(popped);
+                    if (popped == 0)
+                        ::std::this_thread::yield();
+                }
+            });
+        }
+        for (auto&& thread: threads)
+            thread.join();
+        return sum.load();
+    };
+    constexpr static size_t expected = nb_producers * nb_tasks * (nb_producers * nb_tasks - 1) / 2;
+    MpscFunctionQueue<void()> mpsc{64};
+    MpmcFunctionQueue<void()> mpmc{64};
+    ::std::cout << "- [mpsc] " << nb_producers << " producers, 1 consumer: " << (run(mpsc, 1) == expected ? "all tasks ran once" : "lost/duplicated tasks") << ::std::endl;
+    ::std::cout << "- [mpmc] " << nb_producers << " producers, 3 consumers: " << (run(mpmc, 3) == expected ? "all tasks ran once" : "lost/duplicated tasks") << ::std::endl;
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Work-stealing executor manipulation.
+**/
+static void test_executor() {
+    constexpr static size_t nb_tasks = 10000;
+    ::std::cout << "Executor:" << ::std::endl;
+    Executor<> executor{4, 64};
+    { // Fan-out from a non-worker thread, through the (small) shared queue
+        ::std::atomic<size_t> sum{0};
+        for (size_t i = 0; i < nb_tasks; ++i)
+            executor.post([&sum, i]() { sum.fetch_add(i, ::std::memory_order_relaxed); });
+        executor.wait_idle();
+        ::std::cout << "- [fan-out] " << executor.size() << " workers: " << (sum.load() == nb_tasks * (nb_tasks - 1) / 2 ? "all tasks ran once" : "lost/duplicated tasks") << ::std::endl;
+    }
+    { // Fork-join from the workers, through their deques
+        ::std::atomic<size_t> leaves{0};
+        struct Fork {
+            Executor<>* executor;
+            ::std::atomic<size_t>* leaves;
+            size_t depth;
+            void operator()() const {
+                if (depth == 0) {
+                    leaves->fetch_add(1, ::std::memory_order_relaxed);
+                    return;
+                }
+                executor->post(Fork{executor, leaves, depth - 1});
+                executor->post(Fork{executor, leaves, depth - 1});
+            }
+        };
+        executor.post(Fork{&executor, &leaves, 14});
+        executor.wait_idle();
+        ::std::cout << "- [fork-join] depth 14: " << leaves.load() << " leaves" << ::std::endl;
+    }
+    { // Posted function holders moved into the task, not wrapped in another holder
+        ::std::atomic<size_t> sum{0};
+        auto before = Executor<>::Task::statistics().heap_allocations.load();
+        for (size_t i = 0; i < 100; ++i)
+            executor.post(Executor<>::Task{[&sum, i]() { sum.fetch_add(i, ::std::memory_order_relaxed); }});
+        executor.wait_idle();
+        ::std::cout << "- [post] 100 tasks: " << sum.load() << ", " << Executor<>::Task::statistics().heap_allocations.load() - before << " allocation(s)" << ::std::endl;
+    }
+    { // Non-relocatable closures stored inline (and stolen), futures of submitted tasks
+        ::std::string text{"submitted"};
+        auto future = executor.submit([text]() { return text + " task"; });
+        auto count = executor.submit([&executor]() {
+            auto inner = ::std::make_shared<::std::atomic<int>>(0);
+            for (int i = 0; i < 100; ++i)
+                executor.post([inner, name = ::std::string{"nested"}]() { inner->fetch_add(static_cast<int>(name.size())); });
+            return inner;
+        });
+        ::std::cout << "- [submit] " << future.get() << ::std::endl;
+        auto inner = count.get();
+        executor.wait_idle();
+        ::std::cout << "- [submit] nested posts: " << inner->load() << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Function vector manipulation.
+**/
+static void test_vector() {
+    constexpr static size_t nb_functions = 1000;
+    ::std::cout << "Function vector:" << ::std::endl;
+    static size_t alive = 0;
+    class Counted final { // Tracks live instances, not trivially relocatable
+    private:
+        size_t* sum;
+    public:
+        Counted(size_t* sum): sum(sum) { ++alive; }
+        Counted(Counted&& other) noexcept: sum(other.sum) { ++alive; }
+        ~Counted() { --alive; }
+        void operator()(size_t value) { *sum += value; }
+    };
+    class Throwing final { // Move constructor could throw, so heap-stored
+    public:
+        size_t* sum;
+        Throwing(size_t* sum): sum(sum) {}
+        Throwing(Throwing const& other): sum(other.sum) {}
+        void operator()(size_t value) { *sum += 2 * value; }
+    };
+    size_t sum = 0;
+    size_t expected = 0;
+    ::std::vector<FunctionVector<void(size_t)>::Handle> handles;
+    {
+        FunctionVector<void(size_t)> functions;
+        for (size_t i = 0; i < nb_functions; ++i) { // Closures of varying sizes
+            switch (i % 4) {
+            case 0:
+                handles.push_back(functions.insert([&sum](size_t value) { sum += value; }));
+                break;
+            case 1:
+                handles.push_back(functions.insert([&sum, padding = ::std::array<size_t, 8>{}](size_t value) { sum += value + padding[0]; }));
+                break;
+            case 2:
+                handles.push_back(functions.emplace<Counted>(&sum));
+                break;
+            default:
+                handles.push_back(functions.emplace<Throwing>(&sum));
+                break;
+            }
+            expected += i % 4 == 3 ? 2 : 1;
+        }
+        functions(1);
+        ::std::cout << "- [call] " << functions.size() << " functions: " << (sum == expected ? "all called once" : "missed/duplicated calls") << ", live counted: " << alive << ", arena: " << functions.arena_used() << " bytes" << ::std::endl;
+        for (size_t i = 0; i < nb_functions; i += 2) { // Remove half of them, then insert again to trigger compaction
+            functions.erase(handles[i]);
+            expected -= i % 4 == 3 ? 2 : 1;
+        }
+        auto stale = functions.erase(handles[0]);
+        for (size_t i = 0; i < nb_functions / 2; ++i) {
+            handles[2 * i] = functions.emplace<Counted>(&sum);
+            ++expected;
+        }
+        sum = 0;
+        functions(1);
+        ::std::cout << "- [erase] stale handle removed: " << stale << ", " << functions.size() << " functions: " << (sum == expected ? "all called once" : "missed/duplicated calls") << ", live counted: " << alive << ", arena: " << functions.arena_used() << "/" << functions.arena_capacity() << " bytes" << ::std::endl;
+    }
+    ::std::cout << "- [clear] live counted: " << alive << ::std::endl;
+    { // Compaction after a removal changed the call order, so the padding between closures
+        FunctionVector<void(size_t)> functions;
+        sum = 0;
+        auto first = functions.insert([&sum](size_t value) { sum += value; });
+        for (size_t i = 1; i < 40; ++i)
+            functions.insert([&sum](size_t value) { sum += value; });
+        for (size_t i = 0; i < 40; ++i)
+            functions.insert([](size_t) {});
+        functions.erase(first);
+        functions.shrink_to_fit();
+        functions(1);
+        auto shrunk = functions.arena_capacity();
+        functions.reserve(100, 1024);
+        functions(1);
+        ::std::cout << "- [shrink_to_fit] " << functions.size() << " functions, calls: " << sum << ", arena: " << shrunk << " then " << functions.arena_capacity() << " bytes (reserved)" << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Batch invocation.
+**/
+static void test_batch() {
+    ::std::cout << "Batch invocation:" << ::std::endl;
+    { // Same arguments, in order or grouped by invoker once
+        ::std::vector<Function<void(::std::string&)>> funcs;
+        for (size_t i = 0; i < 9; ++i) {
+            switch (i % 3) {
+            case 0: funcs.emplace_back([](::std::string& log) { log += 'a'; }); break;
+            case 1: funcs.emplace_back([](::std::string& log) { log += 'b'; }); break;
+            default: funcs.emplace_back([](::std::string& log) { log += 'c'; }); break;
+            }
+        }
+        ::std::string log;
+        invoke_all(funcs, log);
+        ::std::cout << "- [invoke_all] in order: " << log << ::std::endl;
+        BatchCalls<void(::std::string&)> batch{funcs};
+        log.clear();
+        batch(log);
+        auto grouped = true;
+        for (size_t i = 1; i < log.size(); ++i) {
+            if (log[i] != log[i - 1] && log.find(log[i]) != i) // Letter seen before, not contiguous
+                grouped = false;
+        }
+        ::std::cout << "- [BatchCalls] by invoker: " << batch.size() << " calls in " << batch.groups() << " groups, " << (grouped ? "contiguous" : "not contiguous") << ::std::endl;
+    }
+    { // Several argument sets, arguments never moved from
+        Function<::std::string(::std::string, int)> repeat = [](::std::string text, int count) {
+            ::std::string result;
+            for (int i = 0; i < count; ++i)
+                result += text;
+            return result;
+        };
+        ::std::vector<::std::tuple<::std::string, int>> tuples{::std::make_tuple("ab", 1), ::std::make_tuple("c", 3), ::std::make_tuple("de", 2)};
+        ::std::vector<::std::string> results;
+        invoke_each(repeat, tuples, ::std::back_inserter(results));
+        ::std::cout << "- [invoke_each]";
+        for (auto&& result: results)
+            ::std::cout << " " << result;
+        ::std::cout << ", arguments kept: " << ::std::get<0>(tuples[0]) << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Future/promise manipulation.
+**/
+static void test_future() {
+    ::std::cout << "Future/promise:" << ::std::endl;
+    { // Continuations chained before the value, settled from another thread
+        Promise<int> promise;
+        auto future = promise.get_future()
+            .then([](int value) { return value * 2; })
+            .then([](int value) { return ::std::to_string(value); })
+            .then([](::std::string text) { return text + "!"; })
+            .then([](::std::string text) { return text.size(); });
+        ::std::thread thread{[&]() { promise.set_value(21); }};
+        ::std::cout << "- [then] 4 continuations, size of \"42!\": " << future.get() << ::std::endl;
+        thread.join();
+    }
+    { // More continuations than the state holds, then chained on a ready future
+        Promise<int> promise;
+        auto future = promise.get_future();
+        for (int i = 0; i < 10; ++i)
+            future = future.then([](int value) { return value + 1; });
+        promise.set_value(0);
+        auto done = future.then([](int value) { ::std::cout << "- [then] 10 pending continuations: " << value; });
+        done.get();
+        ::std::cout << ", void future consumed: " << !done.valid() << ::std::endl;
+    }
+    { // Errors skip the continuations
+        Promise<int> promise;
+        auto future = promise.get_future()
+            .then([](int value) -> int { if (value > 0) throw ::std::runtime_error{"thrown by a continuation"}; return value; })
+            .then([](int value) { return value + 1; });
+        promise.set_value(1);
+        try {
+            future.get();
+            ::std::cout << "- [error] not raised" << ::std::endl;
+        } catch (::std::runtime_error const& err) {
+            ::std::cout << "- [error] " << err.what() << ::std::endl;
+        }
+        Future<int> broken;
+        {
+            Promise<int> dropped;
+            broken = dropped.get_future().then([](int value) { return value; });
+        }
+        try {
+            broken.get();
+        } catch (Exception::BrokenPromise const& err) {
+            ::std::cout << "- [error] " << err.what() << ::std::endl;
+        }
+    }
+    { // Joins
+        Promise<int> a;
+        Promise<::std::string> b;
+        auto all = when_all(a.get_future(), b.get_future().then([](::std::string text) { return text + "b"; }));
+        Promise<int> c;
+        Promise<int> d;
+        auto any = when_any(c.get_future(), d.get_future());
+        ::std::thread thread{[&]() {
+            b.set_value("b");
+            d.set_value(4);
+            a.set_value(1);
+            c.set_value(3);
+        }};
+        auto values = all.get();
+        auto first = any.get();
+        thread.join();
+        ::std::cout << "- [when_all] " << ::std::get<0>(values) << ", " << ::std::get<1>(values) << ::std::endl;
+        ::std::cout << "- [when_any] future #" << first.first << ": " << first.second << ::std::endl;
+    }
+    { // Joins of 'void' futures, holding 'Unit' values
+        Promise<void> a;
+        Promise<int> b;
+        auto all = when_all(a.get_future(), b.get_future());
+        static_assert(::std::is_same<decltype(all), Future<::std::tuple<Unit, int>>>::value, "Unexpected joined value class");
+        Promise<void> c;
+        auto any = when_any(c.get_future(), make_ready_future());
+        b.set_value(2);
+        ::std::cout << "- [when_all] with a void future, ready: " << all.is_ready();
+        a.set_value();
+        ::std::cout << ", then: " << ::std::get<1>(all.get()) << ::std::endl;
+        ::std::cout << "- [when_any] void futures: future #" << any.get().first << ::std::endl;
+    }
+    { // Joined value throwing when moved: the join holds the error, the promise settles
+        struct Fragile {
+            bool armed;
+            explicit Fragile(bool armed): armed(armed) {}
+            Fragile(Fragile&& other): armed(other.armed) {
+                if (armed)
+                    throw ::std::runtime_error{"thrown by a moved value"};
+            }
+        };
+        Promise<Fragile> promise;
+        auto any = when_any(promise.get_future());
+        promise.set_value(true);
+        try {
+            any.get();
+            ::std::cout << "- [when_any] not raised" << ::std::endl;
+        } catch (::std::runtime_error const& err) {
+            ::std::cout << "- [when_any] " << err.what() << ::std::endl;
+        }
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+static void test_timer() {
+    ::std::cout << "Timing wheel:" << ::std::endl;
+    { // Random delays over several levels, a third cancelled
+        TimingWheel<> wheel;
+        ::std::vector<uint64_t> expiries;
+        ::std::vector<uint64_t> fired_at;
+        ::std::vector<TimingWheel<>::Timer> timers;
+        uint64_t seed = 42;
+        for (size_t i = 0; i < 3000; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            auto delay = (seed >> 33) % (uint64_t{1} << (6 * (i % 4) + 6));
+            expiries.push_back(delay);
+            fired_at.push_back(0);
+            timers.push_back(wheel.schedule(delay, [&wheel, &fired_at, i]() { fired_at[i] = wheel.now() + 1; }));
+        }
+        size_t cancelled = 0;
+        for (size_t i = 0; i < timers.size(); i += 3)
+            cancelled += wheel.cancel(timers[i]);
+        auto far = wheel.schedule(uint64_t{1} << 40, []() {});
+        auto fired = wheel.advance(uint64_t{1} << 24);
+        size_t correct = 0;
+        for (size_t i = 0; i < timers.size(); ++i)
+            correct += (i % 3 == 0) ? (fired_at[i] == 0) : (fired_at[i] == expiries[i] + 1);
+        ::std::cout << "- [cancel] " << cancelled << " cancelled, twice: " << wheel.cancel(timers[0]) << ::std::endl;
+        ::std::cout << "- [advance] " << fired << " fired, " << correct << "/" << timers.size() << " as expected, " << wheel.size() << " pending" << ::std::endl;
+        fired = wheel.advance(uint64_t{1} << 40);
+        ::std::cout << "- [overflow] fired: " << fired << ", still pending: " << wheel.pending(far) << ::std::endl;
+    }
+    { // Periodic timer, rescheduled by its callback
+        TimingWheel<> wheel;
+        size_t ticks = 0;
+        uint64_t immediate = 0;
+        ::std::function<void()> periodic = [&]() {
+            if (++ticks < 5)
+                wheel.schedule(100, [&]() { periodic(); });
+            if (ticks == 3) // Same tick, fired by the same call
+                wheel.schedule(0, [&]() { immediate = wheel.now(); });
+        };
+        wheel.schedule(100, [&]() { periodic(); });
+        wheel.advance(10000);
+        ::std::cout << "- [periodic] " << ticks << " ticks, immediate at tick " << immediate << ", " << wheel.size() << " pending" << ::std::endl;
+    }
+}
+
+// ―――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――――
+
+/** Member function delegates.
+**/
+static void test_delegate() {
+    /** Object with member functions to bind.
+    **/
+    class Counter final {
+    private:
+        int total = 0; // Sum of the added values
+    public:
+        int add(int value) {
+            return total += value;
+        }
+        int get() const {
+            return total;
+        }
+    };
+    ::std::cout << "Member function delegates:" << ::std::endl;
+    Counter counter;
+    Counter const& view = counter;
+    auto add = Function<int(int)>::bind<decltype(&Counter::add), &Counter::add>(counter);
+    auto get = Function<int()>::bind<decltype(&Counter::get), &Counter::get>(view);
+    Function<int(int)> copy = add;
+    UniqueFunction<int(int), 64> moved{::std::move(copy)};
+    InplaceFunction<int(int), 8> small = add;
+    add(1);
+    moved(2);
+    small(3);
+    ::std::cout << "- [bind] total after 3 calls through copies: " << get() << ", moved-from empty: " << !copy << ::std::endl;
+    using Bound = Delegate<Counter, decltype(&Counter::add), &Counter::add>;
+    ::std::cout << "- [target] stored locally: " << Function<int(int)>::fits_local<Bound>() << ", held as delegates: " << (small.target<Bound>() != nullptr && moved.target<Bound>() != nullptr) << ::std::endl;
+    add = nullptr;
+    ::std::cout << "- [clear] empty: " << !add << ", others still bound: " << moved(4) << ::std::endl;
+}
+
 // ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
 // ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔ Tests ▔
 // ▁ Entry point ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁
@@ -309,6 +1446,27 @@ int main(int argc, char** argv) {
         test_lambda();
         test_bind();
         test_functor();
+        test_unique();
+        test_relocatable();
+        test_resource();
+        test_pool();
+        test_layout();
+        test_ref();
+        test_shared();
+        test_emplace();
+        test_statistics();
+        test_inplace();
+        test_forward();
+        test_overloads();
+        test_target();
+        test_atomic();
+        test_queue();
+        test_executor();
+        test_vector();
+        test_batch();
+        test_future();
+        test_timer();
+        test_delegate();
     } catch (Exception::Any const& err) {
         ::std::cout << err.what() << ::std::endl;
     }